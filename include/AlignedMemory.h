@@ -0,0 +1,54 @@
+#ifndef ALIGNED_MEMORY_H
+#define ALIGNED_MEMORY_H
+
+
+/**
+********************************************************************************
+*
+*   @file       AlignedMemory.h
+*
+*   @brief      Allocation of memory blocks aligned on cache lines.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <cstddef>
+
+//******************************************************************************
+//  Define
+//******************************************************************************
+/// Alignment of the memory blocks (in bytes), i.e. the size of a cache line
+#define MEMORY_ALIGNMENT 64
+
+
+//------------------------------------------------------------------------
+/// Allocate a memory block aligned on MEMORY_ALIGNMENT bytes.
+/**
+* @param aSize: the size of the block (in bytes)
+* @return the memory block (0 if aSize is 0)
+*/
+//------------------------------------------------------------------------
+void* allocateAligned(std::size_t aSize);
+
+
+//------------------------------------------------------------------------
+/// Release a memory block allocated with allocateAligned.
+/**
+* @param apData: the memory block (can be 0)
+*/
+//------------------------------------------------------------------------
+void releaseAligned(void* apData);
+
+#endif
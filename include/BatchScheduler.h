@@ -0,0 +1,267 @@
+#ifndef BATCH_SCHEDULER_H
+#define BATCH_SCHEDULER_H
+
+
+/**
+********************************************************************************
+*
+*   @file       BatchScheduler.h
+*
+*   @brief      Work-stealing scheduler to run many independent image jobs.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Image.h"
+
+
+/// Independent task of a batch
+typedef std::function<void ()> BatchTask;
+
+
+//==============================================================================
+/**
+*   @class  BatchScheduler
+*   @brief  BatchScheduler is a class to run a set of independent tasks
+*           (e.g. several filters on several images) concurrently. Each
+*           thread has its own queue of tasks. When it is empty, the thread
+*           steals tasks from the other queues, so that a few long tasks do
+*           not leave the other threads idle.
+*
+*           The filters called by a task run in the thread of the task
+*           (see SerialRegion): the parallelism comes from the batch.
+*/
+//==============================================================================
+class BatchScheduler
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor.
+    /**
+    * @param aNumberOfThreads: the number of threads, including the calling
+    *                          thread (0 for the default number of threads,
+    *                          see ThreadPool::getDefaultNumberOfThreads)
+    */
+    //------------------------------------------------------------------------
+    explicit BatchScheduler(unsigned int aNumberOfThreads);
+
+
+    //------------------------------------------------------------------------
+    /// Destructor, the worker threads are stopped.
+    //------------------------------------------------------------------------
+    ~BatchScheduler();
+
+
+    //------------------------------------------------------------------------
+    /// Number of threads, including the calling thread.
+    /**
+    * @return the number of threads
+    */
+    //------------------------------------------------------------------------
+    unsigned int getNumberOfThreads() const;
+
+
+    //------------------------------------------------------------------------
+    /// Run every task of a batch. The call returns when all the tasks are
+    /// finished. If tasks throw, the error of the first of them (in the order
+    /// of the batch) is thrown again. A call from a task runs the whole batch
+    /// in the current thread.
+    /**
+    * @param aTaskSet: the tasks
+    */
+    //------------------------------------------------------------------------
+    void run(const std::vector<BatchTask>& aTaskSet);
+
+
+    //------------------------------------------------------------------------
+    /// The scheduler shared by the batch functions. It is created on first
+    /// use with the default number of threads.
+    /**
+    * @return the scheduler
+    */
+    //------------------------------------------------------------------------
+    static BatchScheduler& getInstance();
+
+
+//******************************************************************************
+private:
+    /// Queue of the indices of the tasks given to a thread
+    struct WorkQueue
+    {
+        /// Protect the queue
+        std::mutex mutex;
+
+        /// The indices of the tasks
+        std::deque<unsigned int> task_set;
+    };
+
+
+    /// The worker threads
+    std::vector<std::thread> m_p_thread_set;
+
+
+    /// One queue per thread, the calling thread uses the first one
+    std::unique_ptr<WorkQueue[]> m_p_queue_set;
+
+
+    /// Serialise the batches posted by different threads
+    std::mutex m_batch_mutex;
+
+
+    /// Protect the batch below
+    std::mutex m_mutex;
+
+
+    /// Wake up the workers when a batch is posted
+    std::condition_variable m_batch_condition;
+
+
+    /// Wake up the calling thread when the batch is finished
+    std::condition_variable m_done_condition;
+
+
+    /// The tasks of the current batch
+    const std::vector<BatchTask>* m_p_task_set;
+
+
+    /// The error raised by each task of the current batch
+    std::vector<std::exception_ptr> m_error_set;
+
+
+    /// The number of workers processing tasks of the current batch
+    unsigned int m_active_workers;
+
+
+    /// Incremented for every batch, the workers wait for a new value
+    unsigned int m_batch_id;
+
+
+    /// True when the workers must stop
+    bool m_stop;
+
+
+    //------------------------------------------------------------------------
+    /// Loop of the worker threads.
+    /**
+    * @param aQueueIndex: the queue of the thread
+    */
+    //------------------------------------------------------------------------
+    void runWorker(unsigned int aQueueIndex);
+
+
+    //------------------------------------------------------------------------
+    /// Process the tasks of a queue, then steal the tasks of the other
+    /// queues until they are all empty.
+    /**
+    * @param aQueueIndex: the queue of the thread
+    */
+    //------------------------------------------------------------------------
+    void processQueues(unsigned int aQueueIndex);
+
+
+    //------------------------------------------------------------------------
+    /// Run a task and keep its error.
+    /**
+    * @param aTaskIndex: the index of the task in the batch
+    */
+    //------------------------------------------------------------------------
+    void runTask(unsigned int aTaskIndex);
+
+
+    BatchScheduler(const BatchScheduler&);
+    BatchScheduler& operator=(const BatchScheduler&);
+};
+
+
+//==============================================================================
+/**
+*   @struct ImageJob
+*   @brief  An operation applied to an image, e.g. a filter.
+*/
+//==============================================================================
+template <typename T>
+struct ImageJob
+//------------------------------------------------------------------------------
+{
+    /// The type of the operation
+    typedef std::function<BasicImage<T> (const BasicImage<T>&)> Operation;
+
+    /// The input image (it must not be modified while the batch runs)
+    const BasicImage<T>* p_input;
+
+    /// The operation
+    Operation operation;
+};
+
+
+//------------------------------------------------------------------------
+/// Build a job.
+/**
+* @param anImage: the input image
+* @param anOperation: the operation applied to the image
+* @return the job
+*/
+//------------------------------------------------------------------------
+template <typename T>
+ImageJob<T> makeImageJob(const BasicImage<T>& anImage,
+                         const typename ImageJob<T>::Operation& anOperation)
+{
+    ImageJob<T> job;
+    job.p_input = &anImage;
+    job.operation = anOperation;
+    return (job);
+}
+
+
+//------------------------------------------------------------------------
+/// Run a batch of jobs with the shared scheduler. Jobs on the same input
+/// and on different inputs run concurrently.
+/**
+* @param aJobSet: the jobs
+* @return the result of each job, in the order of the jobs
+*/
+//------------------------------------------------------------------------
+template <typename T>
+std::vector<BasicImage<T> > processBatch(const std::vector<ImageJob<T> >& aJobSet)
+{
+    std::vector<BasicImage<T> > result_set(aJobSet.size());
+
+    std::vector<BatchTask> task_set;
+    task_set.reserve(aJobSet.size());
+    for (unsigned int i(0); i < aJobSet.size(); ++i)
+    {
+        task_set.push_back([&aJobSet, &result_set, i]() {
+            result_set[i] = aJobSet[i].operation(*aJobSet[i].p_input);
+        });
+    }
+
+    BatchScheduler::getInstance().run(task_set);
+
+    return (result_set);
+}
+
+#endif
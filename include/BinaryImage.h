@@ -0,0 +1,259 @@
+#ifndef BINARY_IMAGE_H
+#define BINARY_IMAGE_H
+
+
+/**
+********************************************************************************
+*
+*   @file       BinaryImage.h
+*
+*   @brief      Binary image (mask) packed at one bit per pixel.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <cstdint>
+#include <vector>
+
+
+//******************************************************************************
+//  Class declarations
+//******************************************************************************
+template <typename T> class BasicImage;
+template <typename T> class BasicImageView;
+
+
+//==============================================================================
+/**
+*   @class  BinaryImage
+*   @brief  BinaryImage is a class to store a mask, e.g. the result of a
+*           thresholding, at one bit per pixel. Each row is stored in 64-bit
+*           words: pixel i of a row is bit i % 64 of word i / 64. The bits
+*           after the last pixel of a row are always 0, so the logical
+*           operations and the area work on whole words.
+*/
+//==============================================================================
+class BinaryImage
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Default constructor, the mask is empty.
+    //------------------------------------------------------------------------
+    BinaryImage();
+
+
+    //------------------------------------------------------------------------
+    /// Constructor to create a mask of a given size, all the pixels are 0.
+    /**
+    * @param aWidth: the width of the mask
+    * @param aHeight: the height of the mask
+    */
+    //------------------------------------------------------------------------
+    BinaryImage(unsigned int aWidth, unsigned int aHeight);
+
+
+    //------------------------------------------------------------------------
+    /// Constructor to threshold a view: the pixels above the threshold are
+    /// 1, the others 0.
+    /**
+    * @param aView: the pixels
+    * @param aThresholdValue: the threshold
+    */
+    //------------------------------------------------------------------------
+    template <typename T>
+    BinaryImage(const BasicImageView<T>& aView, double aThresholdValue);
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the horizontal axis.
+    /**
+    * @return the width
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWidth() const;
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the vertical axis.
+    /**
+    * @return the height
+    */
+    //------------------------------------------------------------------------
+    unsigned int getHeight() const;
+
+
+    //------------------------------------------------------------------------
+    /// Number of words in a row.
+    /**
+    * @return the number of words
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWordsPerRow() const;
+
+
+    //------------------------------------------------------------------------
+    /// Access the words of a row. The bits after the last pixel must stay 0.
+    /**
+    * @param j: the row
+    * @return the first word of the row
+    */
+    //------------------------------------------------------------------------
+    std::uint64_t* getRow(unsigned int j);
+
+
+    //------------------------------------------------------------------------
+    /// Access the words of a row.
+    /**
+    * @param j: the row
+    * @return the first word of the row
+    */
+    //------------------------------------------------------------------------
+    const std::uint64_t* getRow(unsigned int j) const;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on a pixel.
+    /**
+    * @param i: the position of the pixel along the horizontal axis
+    * @param j: the position of the pixel along the vertical axis
+    * @return true if the pixel is set
+    */
+    //------------------------------------------------------------------------
+    bool getPixel(unsigned int i, unsigned int j) const;
+
+
+    //------------------------------------------------------------------------
+    /// Set or clear a pixel.
+    /**
+    * @param i: the position of the pixel along the horizontal axis
+    * @param j: the position of the pixel along the vertical axis
+    * @param aValue: true to set the pixel
+    */
+    //------------------------------------------------------------------------
+    void setPixel(unsigned int i, unsigned int j, bool aValue);
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels set.
+    /**
+    * @return the area of the mask
+    */
+    //------------------------------------------------------------------------
+    unsigned int getArea() const;
+
+
+    //------------------------------------------------------------------------
+    /// Intersection with another mask of the same size.
+    /**
+    * @param aMask: the other mask
+    * @return the mask
+    */
+    //------------------------------------------------------------------------
+    BinaryImage& operator&=(const BinaryImage& aMask);
+
+
+    //------------------------------------------------------------------------
+    /// Union with another mask of the same size.
+    /**
+    * @param aMask: the other mask
+    * @return the mask
+    */
+    //------------------------------------------------------------------------
+    BinaryImage& operator|=(const BinaryImage& aMask);
+
+
+    //------------------------------------------------------------------------
+    /// Exclusive or with another mask of the same size.
+    /**
+    * @param aMask: the other mask
+    * @return the mask
+    */
+    //------------------------------------------------------------------------
+    BinaryImage& operator^=(const BinaryImage& aMask);
+
+
+    //------------------------------------------------------------------------
+    /// Intersection of two masks of the same size.
+    /**
+    * @param aMask: the other mask
+    * @return the intersection
+    */
+    //------------------------------------------------------------------------
+    BinaryImage operator&(const BinaryImage& aMask) const;
+
+
+    //------------------------------------------------------------------------
+    /// Union of two masks of the same size.
+    /**
+    * @param aMask: the other mask
+    * @return the union
+    */
+    //------------------------------------------------------------------------
+    BinaryImage operator|(const BinaryImage& aMask) const;
+
+
+    //------------------------------------------------------------------------
+    /// Exclusive or of two masks of the same size.
+    /**
+    * @param aMask: the other mask
+    * @return the exclusive or
+    */
+    //------------------------------------------------------------------------
+    BinaryImage operator^(const BinaryImage& aMask) const;
+
+
+    //------------------------------------------------------------------------
+    /// Convert the mask into a greyscale image.
+    /**
+    * @param aForegroundValue: the value of the pixels set
+    * @param aBackgroundValue: the value of the other pixels
+    * @return the image
+    */
+    //------------------------------------------------------------------------
+    BasicImage<double> toImage(double aForegroundValue = 1.0,
+                               double aBackgroundValue = 0.0) const;
+
+
+//******************************************************************************
+private:
+    //------------------------------------------------------------------------
+    /// Check that another mask has the same size.
+    /**
+    * @param aMask: the other mask
+    */
+    //------------------------------------------------------------------------
+    void checkSize(const BinaryImage& aMask) const;
+
+
+    /// Number of pixel along the horizontal axis
+    unsigned int m_width;
+
+
+    /// Number of pixel along the vertical axis
+    unsigned int m_height;
+
+
+    /// Number of words in a row
+    unsigned int m_words_per_row;
+
+
+    /// The words, row by row
+    std::vector<std::uint64_t> m_word_set;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef BORDER_POLICY_H
+#define BORDER_POLICY_H
+
+
+/**
+********************************************************************************
+*
+*   @file       BorderPolicy.h
+*
+*   @brief      How neighbourhood filters read pixels outside the image.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Type definitions
+//******************************************************************************
+
+/// The value of the pixels outside the image
+enum BorderPolicy
+{
+    /// The closest pixel of the image (aaa|abcd|ddd)
+    BORDER_CLAMP,
+
+    /// The image is mirrored about its edges (cba|abcd|dcb)
+    BORDER_REFLECT,
+
+    /// The image is repeated (bcd|abcd|abc)
+    BORDER_WRAP,
+
+    /// A constant value (vvv|abcd|vvv)
+    BORDER_CONSTANT
+};
+
+
+//------------------------------------------------------------------------
+/// Compute the position of the pixel read instead of a pixel outside
+/// the image, along one axis.
+/**
+* @param anIndex: the position of the pixel (possibly outside the image)
+* @param aSize: the number of pixels along the axis
+* @param aPolicy: the border policy
+* @return the position of the pixel to read, -1 for the constant value
+*/
+//------------------------------------------------------------------------
+inline int getBorderIndex(int anIndex, int aSize, BorderPolicy aPolicy)
+{
+    // The pixel is inside the image
+    if (anIndex >= 0 && anIndex < aSize)
+    {
+        return (anIndex);
+    }
+
+    switch (aPolicy)
+    {
+    case BORDER_CLAMP:
+        return (anIndex < 0 ? 0 : aSize - 1);
+
+    case BORDER_REFLECT:
+        {
+            // The mirrored image has a period of twice the size
+            int period(2 * aSize);
+            int index(anIndex % period);
+            if (index < 0)
+            {
+                index += period;
+            }
+            return (index < aSize ? index : period - 1 - index);
+        }
+
+    case BORDER_WRAP:
+        {
+            int index(anIndex % aSize);
+            return (index < 0 ? index + aSize : index);
+        }
+
+    default:
+        return (-1);
+    }
+}
+
+#endif
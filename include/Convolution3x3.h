@@ -0,0 +1,52 @@
+#ifndef CONVOLUTION_3X3_H
+#define CONVOLUTION_3X3_H
+
+
+/**
+********************************************************************************
+*
+*   @file       Convolution3x3.h
+*
+*   @brief      Vectorised (SSE2/AVX2) 3x3 convolution of a row of pixels.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//------------------------------------------------------------------------
+/// Compute the 3x3 convolution of aCount consecutive pixels of a row,
+/// away from the image borders. The implementation (AVX2, SSE2 or plain C++)
+/// is selected at runtime depending on the CPU. The taps are accumulated in
+/// the same order as the scalar loop, so the results are identical.
+/**
+* @param apRows: for each of the 3 rows of the kernel, the pixel at the left
+*                of the first output pixel
+* @param aKernel: the 9 coefficients of the kernel, row by row
+* @param apOutput: the output pixels
+* @param aCount: the number of output pixels
+*/
+//------------------------------------------------------------------------
+void convolveRow3x3(const double* const apRows[3],
+                    const double aKernel[9],
+                    double* apOutput,
+                    unsigned int aCount);
+
+
+//------------------------------------------------------------------------
+/// Name of the instruction set used by convolveRow3x3.
+/**
+* @return "AVX2", "SSE2" or "none"
+*/
+//------------------------------------------------------------------------
+const char* getConvolution3x3InstructionSet();
+
+#endif
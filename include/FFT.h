@@ -0,0 +1,145 @@
+#ifndef FFT_H
+#define FFT_H
+
+
+/**
+********************************************************************************
+*
+*   @file       FFT.h
+*
+*   @brief      Mixed-radix fast Fourier transform, with plans cached by
+*               length.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <complex>
+#include <vector>
+
+
+/// A complex sample
+typedef std::complex<double> Complex;
+
+
+//==============================================================================
+/**
+*   @class  FFTPlan
+*   @brief  FFTPlan is a class to compute the discrete Fourier transform of
+*           complex signals of a given length. The length is split into
+*           factors (4, 2, 3, then any odd factor); the butterflies of radix
+*           2, 3 and 4 are specialised, the other factors use a generic
+*           butterfly. Lengths whose prime factors are 2, 3 and 5 are the
+*           fastest (see getFFTSize).
+*
+*           The plans are immutable and can be shared by several threads.
+*/
+//==============================================================================
+class FFTPlan
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor.
+    /**
+    * @param aLength: the number of samples of the signals
+    */
+    //------------------------------------------------------------------------
+    explicit FFTPlan(unsigned int aLength);
+
+
+    //------------------------------------------------------------------------
+    /// Number of samples of the signals.
+    /**
+    * @return the length
+    */
+    //------------------------------------------------------------------------
+    unsigned int getLength() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the transform of a signal. The inverse transform is not
+    /// normalised (the signal is multiplied by the length).
+    /**
+    * @param apInput: the signal
+    * @param apOutput: the transform (it must not overlap the signal)
+    * @param anInverse: true for the inverse transform
+    */
+    //------------------------------------------------------------------------
+    void transform(const Complex* apInput, Complex* apOutput, bool anInverse) const;
+
+
+    //------------------------------------------------------------------------
+    /// The plan of a length. The plans are built once and kept.
+    /**
+    * @param aLength: the number of samples of the signals
+    * @return the plan
+    */
+    //------------------------------------------------------------------------
+    static const FFTPlan& getPlan(unsigned int aLength);
+
+
+//******************************************************************************
+private:
+    //------------------------------------------------------------------------
+    /// Compute one stage of the transform, after the sub-transforms of
+    /// the next factors.
+    /**
+    * @param apOutput: the output of the stage
+    * @param apInput: the first sample of the stage
+    * @param aStride: the distance between two samples of the stage
+    * @param aFactorIndex: the index of the factor of the stage
+    * @param apTwiddles: the twiddle factors (forward or inverse)
+    * @param anInverse: true for the inverse transform
+    */
+    //------------------------------------------------------------------------
+    void transformStage(Complex* apOutput,
+                        const Complex* apInput,
+                        unsigned int aStride,
+                        unsigned int aFactorIndex,
+                        const Complex* apTwiddles,
+                        bool anInverse) const;
+
+
+    /// Number of samples of the signals
+    unsigned int m_length;
+
+
+    /// The factors of the length, each followed by the length divided by
+    /// the factors so far
+    std::vector<unsigned int> m_factor_set;
+
+
+    /// exp(-2 pi i k / length)
+    std::vector<Complex> m_forward_twiddle_set;
+
+
+    /// exp(2 pi i k / length)
+    std::vector<Complex> m_inverse_twiddle_set;
+};
+
+
+//------------------------------------------------------------------------
+/// Smallest length at least aMinimumLength whose prime factors are 2, 3
+/// and 5, for which the transform is the fastest.
+/**
+* @param aMinimumLength: the minimum length
+* @return the length
+*/
+//------------------------------------------------------------------------
+unsigned int getFFTSize(unsigned int aMinimumLength);
+
+#endif
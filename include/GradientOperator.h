@@ -0,0 +1,50 @@
+#ifndef GRADIENT_OPERATOR_H
+#define GRADIENT_OPERATOR_H
+
+
+/**
+********************************************************************************
+*
+*   @file       GradientOperator.h
+*
+*   @brief      Options of the fused 3x3 gradient filter.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Type definitions
+//******************************************************************************
+
+/// The 3x3 derivative kernels
+enum GradientOperator
+{
+    /// Central difference smoothed by (1 2 1)
+    GRADIENT_SOBEL,
+
+    /// Central difference smoothed by (1 1 1)
+    GRADIENT_PREWITT
+};
+
+
+/// How the two derivatives are combined into the edge strength
+enum GradientMagnitude
+{
+    /// |Gx| + |Gy|
+    GRADIENT_L1,
+
+    /// sqrt(Gx^2 + Gy^2)
+    GRADIENT_L2
+};
+
+#endif
@@ -9,7 +9,7 @@
 *
 *   @brief      Class to handle a greyscale image.
 *
-*   @version    1.0
+*   @version    1.1
 *
 *   @todo
 *
@@ -24,24 +24,76 @@
 //******************************************************************************
 //  Include
 //******************************************************************************
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <vector>
+#include <cstdint>
+
+#include "PixelTraits.h"
+#include "AlignedMemory.h"
+#include "BinaryImage.h"
+#include "ImageView.h"
+#include "ImageExpression.h"
+#include "LookUpTable.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Type definitions
+//******************************************************************************
+
+/// The encoding of the pixels in a PGM file
+enum PGMFormat
+{
+    /// Plain text (P2), 8-bit values
+    PGM_ASCII,
+
+    /// Binary (P5), 8-bit values, or 16-bit big-endian values when the
+    /// pixels do not fit in 8 bits
+    PGM_BINARY
+};
+
 
 //==============================================================================
 /**
-*   @class  Image
-*   @brief  Image is a class to manage a greyscale image.
+*   @class  BasicImage
+*   @brief  BasicImage is a class to manage a greyscale image.
+*
+*   The pixels are stored using the type T (e.g. std::uint8_t, std::uint16_t,
+*   float or double). Arithmetic is carried out in double precision, then
+*   converted back to T (see PixelTraits).
+*
+*   The arithmetic operators (+, -, *, / and !) build lazy expressions that
+*   are evaluated when they are assigned to an image (see ImageExpression.h).
+*
+*   On 8-bit and 16-bit images, the in-place point operations (scalar
+*   arithmetic, shift/scale, thresholding) and the negative (operator!)
+*   compute a LookUpTable once when the image has more pixels than the
+*   table has entries.
 */
 //==============================================================================
-class Image
+template <typename T>
+class BasicImage
 //------------------------------------------------------------------------------
 {
+    /// Images of different pixel types can access each other's data
+    template <typename U> friend class BasicImage;
+
+    /// Views write the result of their filters directly
+    template <typename U> friend class BasicImageView;
+
 //******************************************************************************
 public:
+    /// The type used to store a pixel
+    typedef T PixelType;
+
+
+
     //--------------------------------------------------------------------------
     /// Default constructor.
     //--------------------------------------------------------------------------
-    Image();
+    BasicImage();
 
 
     //------------------------------------------------------------------------
@@ -50,7 +102,27 @@ public:
     * @param anImage: the image to copy
     */
     //------------------------------------------------------------------------
-    Image(const Image& anImage);
+    BasicImage(const BasicImage& anImage);
+
+
+    //------------------------------------------------------------------------
+    /// Move constructor. The pixel data of anImage is transferred, not copied.
+    /**
+    * @param anImage: the image to move (left empty)
+    */
+    //------------------------------------------------------------------------
+    BasicImage(BasicImage&& anImage) noexcept;
+
+
+    //------------------------------------------------------------------------
+    /// Conversion constructor from an image of another pixel type.
+    /// The pixel values are rounded and saturated if T is an integer type.
+    /**
+    * @param anImage: the image to convert
+    */
+    //------------------------------------------------------------------------
+    template <typename U>
+    explicit BasicImage(const BasicImage<U>& anImage);
     
     
     //------------------------------------------------------------------------
@@ -61,26 +133,51 @@ public:
     * @param aHeight: the height of the image
     */
     //------------------------------------------------------------------------
-    Image(const double* apData,
+    BasicImage(const T* apData,
                  unsigned int aWidth,
                  unsigned int aHeight);
 
 
+    //------------------------------------------------------------------------
+    /// Constructor from a view (the pixels of the view are copied).
+    /**
+    * @param aView: the view to copy
+    */
+    //------------------------------------------------------------------------
+    explicit BasicImage(const BasicImageView<T>& aView);
+
+
+    //------------------------------------------------------------------------
+    /// Constructor from an arithmetic expression (see ImageExpression.h).
+    /// The expression is evaluated in a single pass.
+    /**
+    * @param anExpression: the expression to evaluate
+    */
+    //------------------------------------------------------------------------
+    template <typename E>
+    BasicImage(const ImageExpression<E>& anExpression);
+
+
     //------------------------------------------------------------------------
     /// Constructor to build a black image.
+    /// Rows are aligned on MEMORY_ALIGNMENT bytes. By default, they are padded
+    /// so that consecutive rows do not map onto the same cache sets.
     /**
     * @param aWidth: the width of the image
     * @param aHeight: the height of the image
+    * @param aStride: the distance between two rows (in number of pixels),
+    *                 rounded up to keep the rows aligned (0 for the default)
     */
     //------------------------------------------------------------------------
-    Image(unsigned int aWidth,
-                 unsigned int aHeight);
+    BasicImage(unsigned int aWidth,
+                 unsigned int aHeight,
+                 unsigned int aStride = 0);
 
 
     //------------------------------------------------------------------------
     /// Destructor.
     //------------------------------------------------------------------------
-    ~Image();
+    ~BasicImage();
     
     
     //------------------------------------------------------------------------
@@ -90,7 +187,31 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator=(const Image& anImage);
+    BasicImage& operator=(const BasicImage& anImage);
+
+
+    //------------------------------------------------------------------------
+    /// Move assignment operator. The pixel data of anImage is transferred,
+    /// not copied.
+    /**
+    * @param anImage: the image to move (left empty)
+    * @return the updated version of the current image
+    */
+    //------------------------------------------------------------------------
+    BasicImage& operator=(BasicImage&& anImage) noexcept;
+
+
+    //------------------------------------------------------------------------
+    /// Assignment operator from an arithmetic expression, which is evaluated
+    /// in a single pass. The pixel buffer is re-used when the size of the
+    /// image does not change (the expression may refer to the image itself).
+    /**
+    * @param anExpression: the expression to evaluate
+    * @return the updated version of the current image
+    */
+    //------------------------------------------------------------------------
+    template <typename E>
+    BasicImage& operator=(const ImageExpression<E>& anExpression);
     
     
     //------------------------------------------------------------------------
@@ -100,7 +221,8 @@ public:
     
     
     //------------------------------------------------------------------------
-    /// Compute a region of interest (ROI).
+    /// Compute a region of interest (ROI). The pixels are not copied, the
+    /// ROI is a view on the current image, clipped to the image.
     /**
     * @param i: the position of the first pixel of the ROI along the horizontal axis
     * @param j: the position of the first pixel of the ROI along the vertical axis
@@ -109,12 +231,21 @@ public:
     * @return the ROI
     */
     //------------------------------------------------------------------------
-    Image getROI(unsigned int i,
+    BasicImageView<T> getROI(unsigned int i,
             unsigned int j,
             unsigned int aWidth,
             unsigned int aHeight) const;
 
 
+    //------------------------------------------------------------------------
+    /// View on the whole image, without copy.
+    /**
+    * @return the view
+    */
+    //------------------------------------------------------------------------
+    BasicImageView<T> getView() const;
+
+
     //------------------------------------------------------------------------
     /// Set a pixel.
     /**
@@ -123,7 +254,7 @@ public:
     * @param aValue: the new pixel value
     */
     //------------------------------------------------------------------------
-    void setPixel(unsigned int i, unsigned int j, double aValue);
+    void setPixel(unsigned int i, unsigned int j, T aValue);
     
     
     //------------------------------------------------------------------------
@@ -134,27 +265,28 @@ public:
     * @return the pixel value
     */
     //------------------------------------------------------------------------
-    double getPixel(unsigned int i, unsigned int j) const;
+    T getPixel(unsigned int i, unsigned int j) const;
     
     
     //------------------------------------------------------------------------
-    /// Addition operator. Add anImage
+    /// Accessor on a row of pixels. The pixels may be changed through the
+    /// pointer until the statistics of the image are queried again.
     /**
-    * @param anImage: the image to add
-    * @return the resulting image
+    * @param j: the position of the row along the vertical axis
+    * @return the first pixel of the row
     */
     //------------------------------------------------------------------------
-    Image operator+(const Image& anImage);
-    
-    
+    T* getRow(unsigned int j);
+
+
     //------------------------------------------------------------------------
-    /// Subtraction operator. Add anImage
+    /// Accessor on a row of pixels.
     /**
-    * @param anImage: the image to subtract
-    * @return the resulting image
+    * @param j: the position of the row along the vertical axis
+    * @return the first pixel of the row
     */
     //------------------------------------------------------------------------
-    Image operator-(const Image& anImage);
+    const T* getRow(unsigned int j) const;
 
 
     //------------------------------------------------------------------------
@@ -164,7 +296,7 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator+=(const Image& anImage);
+    BasicImage& operator+=(const BasicImage& anImage);
 
 
     //------------------------------------------------------------------------
@@ -174,47 +306,7 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator-=(const Image& anImage);
-    
-    
-    //------------------------------------------------------------------------
-    /// Addition operator. Add aValue to every pixel of the image
-    /**
-    * @param aValue: the value to add
-    * @return the resulting image
-    */
-    //------------------------------------------------------------------------
-    Image operator+(double aValue);
-
-
-    //------------------------------------------------------------------------
-    /// Subtraction operator. Subtract aValue to every pixel of the image
-    /**
-    * @param aValue: the value to subtract
-    * @return the resulting image
-    */
-    //------------------------------------------------------------------------
-    Image operator-(double aValue);
-
-
-    //------------------------------------------------------------------------
-    /// Multiplication operator. Multiply every pixel of the image by aValue
-    /**
-    * @param aValue: the value for the multiplication
-    * @return the resulting image
-    */
-    //------------------------------------------------------------------------
-    Image operator*(double aValue);
-    
-    
-    //------------------------------------------------------------------------
-    /// Division operator. Divide every pixel of the image by aValue
-    /**
-    * @param aValue: the value for the division
-    * @return the resulting image
-    */
-    //------------------------------------------------------------------------
-    Image operator/(double aValue);
+    BasicImage& operator-=(const BasicImage& anImage);
 
 
     //------------------------------------------------------------------------
@@ -224,7 +316,7 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator+=(double aValue);
+    BasicImage& operator+=(double aValue);
 
 
     //------------------------------------------------------------------------
@@ -234,7 +326,7 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator-=(double aValue);
+    BasicImage& operator-=(double aValue);
 
 
     //------------------------------------------------------------------------
@@ -244,7 +336,7 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator*=(double aValue);
+    BasicImage& operator*=(double aValue);
 
 
     //------------------------------------------------------------------------
@@ -254,18 +346,9 @@ public:
     * @return the updated version of the current image
     */
     //------------------------------------------------------------------------
-    Image& operator/=(double aValue);
+    BasicImage& operator/=(double aValue);
 
 
-    //------------------------------------------------------------------------
-    /// Negation operator. Compute the negative of the current image.
-    /**
-    * @return the negative image
-    */
-    //------------------------------------------------------------------------
-    Image operator!();
-    
-
     //------------------------------------------------------------------------
     /// Compute the aspect ratio
     /**
@@ -293,6 +376,26 @@ public:
     unsigned int getHeight() const;
     
 
+    //------------------------------------------------------------------------
+    /// Distance between the first pixels of two consecutive rows
+    /**
+    * @return the stride (in number of pixels)
+    */
+    //------------------------------------------------------------------------
+    unsigned int getStride() const;
+    
+
+    //------------------------------------------------------------------------
+    /// Compute the min, max, sum, average, variance and standard deviation
+    /// of the pixels in a single pass. The result is kept until the pixels
+    /// change, so repeated queries are free.
+    /**
+    * @return the statistics of the image
+    */
+    //------------------------------------------------------------------------
+    ImageStatistics getStatistics() const;
+    
+
     //------------------------------------------------------------------------
     /// Compute the minimum pixel value in the image
     /**
@@ -322,6 +425,17 @@ public:
     void shiftScaleFilter(double aShiftValue, double aScaleValue);
     
     
+    //------------------------------------------------------------------------
+    /// Map every pixel through a table (8-bit and 16-bit images only). A
+    /// chain of point operations built into a single table is applied in a
+    /// single pass.
+    /**
+    * @param aTable: the table
+    */
+    //------------------------------------------------------------------------
+    void applyLUT(const LookUpTable<T>& aTable);
+    
+    
     //------------------------------------------------------------------------
     /// Normalise the image between 0 and 1
     //------------------------------------------------------------------------
@@ -335,7 +449,8 @@ public:
     
     
     //------------------------------------------------------------------------
-    /// Load an image from a PGM file
+    /// Load an image from a PGM file, in plain text (P2) or binary (P5)
+    /// with 8-bit or 16-bit values
     /**
     * @param aFileName: the name of the file to load
     */
@@ -353,21 +468,25 @@ public:
     
     
     //------------------------------------------------------------------------
-    /// Save the image in a PGM file
+    /// Save the image in a PGM file. The binary format is written in a
+    /// single block; it uses 16-bit values for 16-bit images and for
+    /// floating-point images whose maximum is above 255.
     /**
     * @param aFileName: the name of the file to write
+    * @param aFormat: the encoding of the pixels
     */
     //------------------------------------------------------------------------
-    void savePGM(const char* aFileName);
+    void savePGM(const char* aFileName, PGMFormat aFormat = PGM_ASCII) const;
     
     
     //------------------------------------------------------------------------
     /// Save the image in a PGM file
     /**
     * @param aFileName: the name of the file to write
+    * @param aFormat: the encoding of the pixels
     */
     //------------------------------------------------------------------------
-    void savePGM(const std::string& aFileName);
+    void savePGM(const std::string& aFileName, PGMFormat aFormat = PGM_ASCII) const;
     
 
     //------------------------------------------------------------------------
@@ -398,7 +517,7 @@ public:
     * @param aFileName: the name of the file to write
     */
     //------------------------------------------------------------------------
-    void saveRaw(const char* aFileName);
+    void saveRaw(const char* aFileName) const;
     
     
     //------------------------------------------------------------------------
@@ -407,7 +526,7 @@ public:
     * @param aFileName: the name of the file to write
     */
     //------------------------------------------------------------------------
-    void saveRaw(const std::string& aFileName);
+    void saveRaw(const std::string& aFileName) const;
     
 
     //------------------------------------------------------------------------
@@ -434,7 +553,7 @@ public:
     * @param aFileName: the name of the file to write
     */
     //------------------------------------------------------------------------
-    void saveASCII(const char* aFileName);
+    void saveASCII(const char* aFileName) const;
     
     
     //------------------------------------------------------------------------
@@ -443,7 +562,7 @@ public:
     * @param aFileName: the name of the file to write
     */
     //------------------------------------------------------------------------
-    void saveASCII(const std::string& aFileName);
+    void saveASCII(const std::string& aFileName) const;
    
    
     //------------------------------------------------------------------------
@@ -454,7 +573,7 @@ public:
     *         false if they are different
     */
     //------------------------------------------------------------------------
-    bool operator==(const Image& anImage) const;
+    bool operator==(const BasicImage& anImage) const;
 
 
     //------------------------------------------------------------------------
@@ -465,7 +584,7 @@ public:
     *         false if they are similar
     */
     //------------------------------------------------------------------------
-	bool operator!=(const Image& anImage) const;
+	bool operator!=(const BasicImage& anImage) const;
     
     
     //------------------------------------------------------------------------
@@ -475,7 +594,17 @@ public:
      * @return image with absoulte pixel values,
      */
     //------------------------------------------------------------------------
-    Image abs(const Image& aImage);
+    static BasicImage abs(const BasicImage& aImage);
+
+
+    //------------------------------------------------------------------------
+    /// Image with absoulte pixel values, computed in place on a temporary
+    /**
+     * @param aImage: the image manipulate
+     * @return image with absoulte pixel values,
+     */
+    //------------------------------------------------------------------------
+    static BasicImage abs(BasicImage&& aImage);
     
     
     //------------------------------------------------------------------------
@@ -521,7 +650,17 @@ public:
      * @return the SAE
      */
     //------------------------------------------------------------------------
-    double computeSAE(const Image& aImage) const;
+    double computeSAE(const BasicImage& aImage) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the sum of absolute errors (SAE) between the image and a view.
+    /**
+     * @param aView: the view to use in the comparison
+     * @return the SAE
+     */
+    //------------------------------------------------------------------------
+    double computeSAE(const BasicImageView<T>& aView) const;
     
     
     //------------------------------------------------------------------------
@@ -531,7 +670,17 @@ public:
      * @return the NCC
      */
     //------------------------------------------------------------------------
-    double computeNCC(const Image& aImage) const;
+    double computeNCC(const BasicImage& aImage) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the normalised-cross correlation (NCC) between the image and a view.
+    /**
+     * @param aView: the view to use in the comparison
+     * @return the NCC
+     */
+    //------------------------------------------------------------------------
+    double computeNCC(const BasicImageView<T>& aView) const;
     
     
     //------------------------------------------------------------------------
@@ -541,25 +690,98 @@ public:
      * @return image with provided kernel
      */
     //------------------------------------------------------------------------
-    Image convolution(double kernelArray[]);
+    BasicImage convolution(double kernelArray[]) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convoultion of an image with a kernel of any size.
+    /// Separable kernels are applied as a row pass followed by a column pass,
+    /// large non-separable kernels as a product of spectra (see Spectrum).
+    /**
+     * @param aKernel: the kernel
+     * @param aMethod: how the convolution is carried out
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    BasicImage convolution(const Kernel& aKernel,
+                           ConvolutionMethod aMethod = CONVOLUTION_AUTOMATIC,
+                           BorderPolicy aBorder = BORDER_CLAMP,
+                           double aBorderValue = 0.0) const;
 
     
     //------------------------------------------------------------------------
     /// Compute the median filter to an image.
     /**
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
      * @return image with median filter applied
      */
     //------------------------------------------------------------------------
-    Image medianFilter();
+    BasicImage medianFilter(BorderPolicy aBorder = BORDER_CLAMP,
+                            double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the median filter of a square window of any radius.
+    /**
+     * @param aRadius: the radius of the window ((2 * aRadius + 1)^2 pixels)
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
+     * @return image with median filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage medianFilter(unsigned int aRadius,
+                            BorderPolicy aBorder = BORDER_CLAMP,
+                            double aBorderValue = 0.0) const;
     
     
     //------------------------------------------------------------------------
-    /// Compute the mean filter to an image.
+    /// Compute the mean filter to an image (3x3 window).
     /**
      * @return image with mean filter applied
      */
     //------------------------------------------------------------------------
-    Image meanFilter();
+    BasicImage meanFilter() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the mean filter of a square window of any radius, in a time
+    /// that does not depend on the radius (see IntegralImage).
+    /**
+     * @param aRadius: the radius of the window ((2 * aRadius + 1)^2 pixels)
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
+     * @return image with mean filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage meanFilter(unsigned int aRadius,
+                          BorderPolicy aBorder = BORDER_CLAMP,
+                          double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the mean and the variance of the square window centred on
+    /// each pixel.
+    /**
+     * @param aRadius: the radius of the window ((2 * aRadius + 1)^2 pixels)
+     * @param apMean: the local means (ignored if 0)
+     * @param apVariance: the local variances (ignored if 0)
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
+     */
+    //------------------------------------------------------------------------
+    void getLocalStatistics(unsigned int aRadius,
+                            BasicImage<double>* apMean,
+                            BasicImage<double>* apVariance,
+                            BorderPolicy aBorder = BORDER_CLAMP,
+                            double aBorderValue = 0.0) const;
     
     
     //------------------------------------------------------------------------
@@ -568,7 +790,24 @@ public:
      * @return image with gaussian filter applied
      */
     //------------------------------------------------------------------------
-    Image gaussianFilter();
+    BasicImage gaussianFilter() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the gaussian filter of any standard deviation to an image,
+    /// in a time that does not depend on the standard deviation (recursive
+    /// filter, see BasicImageView::gaussianFilter).
+    /**
+     * @param aSigma: the standard deviation of the gaussian (in pixels)
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
+     * @return image with gaussian filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage gaussianFilter(double aSigma,
+                              BorderPolicy aBorder = BORDER_CLAMP,
+                              double aBorderValue = 0.0) const;
     
     
     //------------------------------------------------------------------------
@@ -577,7 +816,27 @@ public:
      * @return image with laplacian filter applied
      */
     //------------------------------------------------------------------------
-    Image laplacianFilter();
+    BasicImage laplacianFilter() const;
+    
+    
+    //------------------------------------------------------------------------
+    /// Compute the edge strength of the image with a 3x3 gradient operator,
+    /// in a single pass.
+    /**
+     * @param anOperator: the derivative kernels (Sobel or Prewitt)
+     * @param aMagnitude: how Gx and Gy are combined
+     * @param apOrientation: if not null, receives atan2(Gy, Gx) in radians
+     * @param aBorder: how the pixels outside the image are read
+     * @param aBorderValue: the value of the pixels outside the image
+     *                      (BORDER_CONSTANT only)
+     * @return the gradient magnitude
+     */
+    //------------------------------------------------------------------------
+    BasicImage gradient(GradientOperator anOperator = GRADIENT_SOBEL,
+                        GradientMagnitude aMagnitude = GRADIENT_L1,
+                        BasicImage<double>* apOrientation = 0,
+                        BorderPolicy aBorder = BORDER_CLAMP,
+                        double aBorderValue = 0.0) const;
     
     
     //------------------------------------------------------------------------
@@ -586,7 +845,7 @@ public:
      * @return image with sobel edge detection filter applied
      */
     //------------------------------------------------------------------------
-    Image sobelEdgeDetector();
+    BasicImage sobelEdgeDetector() const;
     
     
     //------------------------------------------------------------------------
@@ -595,17 +854,22 @@ public:
      * @return image with prewitt edge detection filter applied
      */
     //------------------------------------------------------------------------
-    Image prewittEdgeDetector();
+    BasicImage prewittEdgeDetector() const;
     
     
     //------------------------------------------------------------------------
-    ///  Sharpens an image.
+    ///  Sharpens an image (unsharp mask computed in a single pass).
     /**
      * @param sharpenValue: amount the image is sharpened
+     * @param aRadius: the radius of the blur
+     * @param aThreshold: the pixels whose detail is smaller than aThreshold
+     *                    (in absolute value) are not changed
      * @return image thats been sharpened
      */
     //------------------------------------------------------------------------
-    Image sharpening(double sharpenValue);
+    BasicImage sharpening(double sharpenValue,
+                          unsigned int aRadius = 1,
+                          double aThreshold = 0.0) const;
     
     
     //------------------------------------------------------------------------
@@ -615,7 +879,18 @@ public:
      * @return image with applied threshold
      */
     //------------------------------------------------------------------------
-    Image segmentationThresholding(double thresholdValue);
+    BasicImage segmentationThresholding(double thresholdValue) const;
+    
+    
+    //------------------------------------------------------------------------
+    /// Threshold the image into a mask packed at one bit per pixel: the
+    /// pixels above the threshold are set
+    /**
+     * @param thresholdValue: lowest value in the threshold
+     * @return the mask
+     */
+    //------------------------------------------------------------------------
+    BinaryImage binaryThresholding(double thresholdValue) const;
     
     
     //------------------------------------------------------------------------
@@ -626,11 +901,13 @@ public:
      * @return image with applied threshold
      */
     //------------------------------------------------------------------------
-    Image blending(const Image& aImage, double alpha);
+    BasicImage blending(const BasicImage& aImage, double alpha) const;
     
     
     //------------------------------------------------------------------------
     /// Generated a histogram depending on the amount of bins the user wants
+    /// (the bins are evenly spaced between the min and the max, the max is
+    /// in the last bin)
     /**
      * @param aNumberOfBins: Number of bins to a histogram
      * @return vector containing the amount of values in each bin
@@ -668,9 +945,231 @@ private:
     /// Number of pixel along the vertical axis
     unsigned int m_height;
 
+
+    /// Number of pixel between two rows
+    unsigned int m_stride;
+
     
-    /// The pixel data
-    double* m_p_image;
+    /// The pixel data (aligned on MEMORY_ALIGNMENT bytes)
+    T* m_p_image;
+
+
+    /// The statistics of the pixels, computed when they are first needed
+    mutable ImageStatistics m_statistics;
+
+
+    /// True if m_statistics matches the pixels; every method that may change
+    /// the pixels (including the non-const getRow) resets it. It is set
+    /// (with release semantics) once m_statistics is written. The filters
+    /// reset it once, then their threads write the rows through getRowData
+    mutable std::atomic<bool> m_statistics_valid;
+
+
+    /// Serialise the threads that compute or copy m_statistics
+    mutable std::mutex m_statistics_mutex;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on a row of pixels, which leaves the statistics alone: the
+    /// caller resets them once before its threads write the rows.
+    /**
+    * @param j: the position of the row along the vertical axis
+    * @return the first pixel of the row
+    */
+    //------------------------------------------------------------------------
+    T* getRowData(unsigned int j);
+
+
+    //------------------------------------------------------------------------
+    /// Copy the statistics of another image, which may be computed by
+    /// another thread at the same time.
+    /**
+    * @param anImage: the other image
+    */
+    //------------------------------------------------------------------------
+    void copyStatistics(const BasicImage& anImage);
+
+
+    //------------------------------------------------------------------------
+    /// Round a number of pixels up so that rows stay aligned.
+    /**
+    * @param aWidth: the number of pixels in a row
+    * @return the aligned stride (in number of pixels)
+    */
+    //------------------------------------------------------------------------
+    static unsigned int getAlignedStride(unsigned int aWidth);
+
+
+    //------------------------------------------------------------------------
+    /// Compute the default stride of an image.
+    /**
+    * @param aWidth: the number of pixels in a row
+    * @return the stride (in number of pixels)
+    */
+    //------------------------------------------------------------------------
+    static unsigned int getDefaultStride(unsigned int aWidth);
+
+
+    //------------------------------------------------------------------------
+    /// Allocate an aligned pixel buffer.
+    /**
+    * @param aNumberOfPixels: the number of pixels in the buffer
+    * @return the buffer
+    */
+    //------------------------------------------------------------------------
+    static T* allocatePixels(unsigned int aNumberOfPixels);
+
+
+    //------------------------------------------------------------------------
+    /// Store the pixels of an expression of the same size as the image.
+    /**
+    * @param anExpression: the expression to evaluate
+    */
+    //------------------------------------------------------------------------
+    template <typename E>
+    void evaluate(const ImageExpression<E>& anExpression);
+
+
+    //------------------------------------------------------------------------
+    /// Store the pixels of an expression through a look-up table, when the
+    /// expression is a point operation that has one. Most expressions do not.
+    /**
+    * @return false
+    */
+    //------------------------------------------------------------------------
+    template <typename E>
+    bool evaluateThroughTable(const E&)
+    {
+        return (false);
+    }
+
+
+    //------------------------------------------------------------------------
+    /// Store the negative of an image through a look-up table (8-bit and
+    /// 16-bit images with more pixels than the table has entries).
+    /**
+    * @param anExpression: the negative
+    * @return true if the pixels have been stored, false otherwise
+    */
+    //------------------------------------------------------------------------
+    bool evaluateThroughTable(const ImageNegationExpression<BasicImageView<T> >& anExpression);
 };
 
+
+//******************************************************************************
+//  Pixel types
+//******************************************************************************
+
+/// Image using 8 bits per pixel
+typedef BasicImage<std::uint8_t> Image8;
+
+/// Image using 16 bits per pixel
+typedef BasicImage<std::uint16_t> Image16;
+
+/// Image using single precision floating-point pixels
+typedef BasicImage<float> ImageF;
+
+/// Image using double precision floating-point pixels (default)
+typedef BasicImage<double> Image;
+
+
+//------------------------------------------------------------
+template <typename T>
+template <typename U>
+BasicImage<T>::BasicImage(const BasicImage<U>& anImage):
+//------------------------------------------------------------
+        m_width(anImage.m_width),
+        m_height(anImage.m_height),
+        m_stride(getDefaultStride(m_width)),
+        m_p_image(allocatePixels(m_height * m_stride)),
+        m_statistics(),
+        m_statistics_valid(false)
+//------------------------------------------------------------
+{
+    // Convert the data
+    for (unsigned int j(0); j < m_height; ++j)
+    {
+        const U* p_input(anImage.getRow(j));
+        T* p_output(getRow(j));
+
+        for (unsigned int i(0); i < m_width; ++i)
+        {
+            p_output[i] = PixelTraits<T>::fromDouble(p_input[i]);
+        }
+    }
+}
+
+//------------------------------------------------------------
+template <typename T>
+template <typename E>
+BasicImage<T>::BasicImage(const ImageExpression<E>& anExpression):
+//------------------------------------------------------------
+        m_width(anExpression.getWidth()),
+        m_height(anExpression.getHeight()),
+        m_stride(getDefaultStride(m_width)),
+        m_p_image(allocatePixels(m_height * m_stride)),
+        m_statistics(),
+        m_statistics_valid(false)
+//------------------------------------------------------------
+{
+    evaluate(anExpression);
+}
+
+
+//------------------------------------------------------------
+template <typename T>
+template <typename E>
+BasicImage<T>& BasicImage<T>::operator=(const ImageExpression<E>& anExpression)
+//------------------------------------------------------------
+{
+    // Every pixel only depends on the pixels at the same position in the
+    // operands, the expression can be evaluated in place
+    if (m_p_image &&
+            m_width == anExpression.getWidth() &&
+            m_height == anExpression.getHeight())
+    {
+        evaluate(anExpression);
+    }
+    // The size changes, a new buffer is needed
+    else
+    {
+        *this = BasicImage(anExpression);
+    }
+
+    // Return the instance
+    return (*this);
+}
+
+
+//------------------------------------------------------------
+template <typename T>
+template <typename E>
+void BasicImage<T>::evaluate(const ImageExpression<E>& anExpression)
+//------------------------------------------------------------
+{
+    const E& expression(anExpression.derived());
+
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
+
+    // A single lookup per pixel
+    if (evaluateThroughTable(expression))
+    {
+        return;
+    }
+
+    // Process every pixel in a single loop, by bands of rows
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            T* p_temp(getRowData(j));
+
+            for (unsigned int i(0); i < m_width; ++i)
+            {
+                p_temp[i] = PixelTraits<T>::fromDouble(expression(i, j));
+            }
+        }
+    });
+}
+
 #endif
@@ -0,0 +1,543 @@
+#ifndef IMAGE_EXPRESSION_H
+#define IMAGE_EXPRESSION_H
+
+
+/**
+********************************************************************************
+*
+*   @file       ImageExpression.h
+*
+*   @brief      Lazy arithmetic on greyscale images (expression templates).
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "ImageView.h"
+
+//******************************************************************************
+//  Forward declaration
+//******************************************************************************
+template <typename T> class BasicImage;
+
+//==============================================================================
+/**
+*   @class  ImageExpression
+*   @brief  ImageExpression is the base class of the arithmetic operations
+*           on images. The operators (+, -, *, / and !) do not compute
+*           anything: they build an expression that is evaluated in a single
+*           loop when it is assigned to a BasicImage, without any temporary
+*           image. Every pixel is computed in double precision and converted
+*           only once into the pixel type of the destination.
+*
+*   An expression refers to the pixels of its operands: it must be assigned
+*   to an image before the end of the statement that created it (i.e. do not
+*   store an expression in an auto variable).
+*/
+//==============================================================================
+template <typename E>
+class ImageExpression
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Accessor on the actual expression.
+    /**
+    * @return the expression
+    */
+    //------------------------------------------------------------------------
+    const E& derived() const
+    {
+        return (static_cast<const E&>(*this));
+    }
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the horizontal axis
+    /**
+    * @return the width
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWidth() const
+    {
+        return (derived().getWidth());
+    }
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the vertical axis
+    /**
+    * @return the height
+    */
+    //------------------------------------------------------------------------
+    unsigned int getHeight() const
+    {
+        return (derived().getHeight());
+    }
+
+
+    //------------------------------------------------------------------------
+    /// Compute a pixel value of the expression.
+    /**
+    * @param i: the position of the pixel along the horizontal axis
+    * @param j: the position of the pixel along the vertical axis
+    * @return the pixel value
+    */
+    //------------------------------------------------------------------------
+    double operator()(unsigned int i, unsigned int j) const
+    {
+        return (derived()(i, j));
+    }
+};
+
+
+//==============================================================================
+/**
+*   @class  ImageOperand
+*   @brief  ImageOperand tells how an operand is stored in an expression.
+*           Images are stored as views, views and expressions are copied
+*           (they are small).
+*/
+//==============================================================================
+template <typename E>
+struct ImageOperand
+//------------------------------------------------------------------------------
+{
+    /// True if E can be used in an expression
+    static const bool IS_OPERAND = std::is_base_of<ImageExpression<E>, E>::value;
+
+    /// The type stored in the expression
+    typedef E Type;
+
+    /// Get the value stored in the expression
+    static const E& get(const E& anOperand)
+    {
+        return (anOperand);
+    }
+};
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+struct ImageOperand<BasicImageView<T> >
+//------------------------------------------------------------------------------
+{
+    static const bool IS_OPERAND = true;
+
+    typedef BasicImageView<T> Type;
+
+    static const Type& get(const Type& aView)
+    {
+        return (aView);
+    }
+};
+
+
+//------------------------------------------------------------------------------
+template <typename T>
+struct ImageOperand<BasicImage<T> >
+//------------------------------------------------------------------------------
+{
+    static const bool IS_OPERAND = true;
+
+    typedef BasicImageView<T> Type;
+
+    static Type get(const BasicImage<T>& anImage)
+    {
+        return (anImage.getView());
+    }
+};
+
+
+//******************************************************************************
+//  Operations
+//******************************************************************************
+
+/// Addition of two pixel values
+struct ImageAddition
+{
+    static double apply(double aLeft, double aRight) { return (aLeft + aRight); }
+};
+
+/// Subtraction of two pixel values
+struct ImageSubtraction
+{
+    static double apply(double aLeft, double aRight) { return (aLeft - aRight); }
+};
+
+/// Multiplication of two pixel values
+struct ImageMultiplication
+{
+    static double apply(double aLeft, double aRight) { return (aLeft * aRight); }
+};
+
+/// Division of two pixel values
+struct ImageDivision
+{
+    static double apply(double aLeft, double aRight) { return (aLeft / aRight); }
+};
+
+
+//==============================================================================
+/**
+*   @class  ImageBinaryExpression
+*   @brief  Pixel-wise operation between two images. Images of different
+*           sizes are supported, only the area common to both is used.
+*/
+//==============================================================================
+template <typename L, typename R, typename Op>
+class ImageBinaryExpression: public ImageExpression<ImageBinaryExpression<L, R, Op> >
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    ImageBinaryExpression(const L& aLeft, const R& aRight):
+            m_left(aLeft),
+            m_right(aRight)
+    {}
+
+
+    unsigned int getWidth() const
+    {
+        return (std::min(m_left.getWidth(), m_right.getWidth()));
+    }
+
+
+    unsigned int getHeight() const
+    {
+        return (std::min(m_left.getHeight(), m_right.getHeight()));
+    }
+
+
+    double operator()(unsigned int i, unsigned int j) const
+    {
+        return (Op::apply(m_left(i, j), m_right(i, j)));
+    }
+
+//******************************************************************************
+private:
+    /// The left-hand side operand
+    L m_left;
+
+
+    /// The right-hand side operand
+    R m_right;
+};
+
+
+//==============================================================================
+/**
+*   @class  ImageScalarExpression
+*   @brief  Operation between every pixel of an image and a scalar value.
+*/
+//==============================================================================
+template <typename E, typename Op>
+class ImageScalarExpression: public ImageExpression<ImageScalarExpression<E, Op> >
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    ImageScalarExpression(const E& anOperand, double aValue):
+            m_operand(anOperand),
+            m_value(aValue)
+    {}
+
+
+    unsigned int getWidth() const
+    {
+        return (m_operand.getWidth());
+    }
+
+
+    unsigned int getHeight() const
+    {
+        return (m_operand.getHeight());
+    }
+
+
+    double operator()(unsigned int i, unsigned int j) const
+    {
+        return (Op::apply(m_operand(i, j), m_value));
+    }
+
+//******************************************************************************
+private:
+    /// The image operand
+    E m_operand;
+
+
+    /// The scalar operand
+    double m_value;
+};
+
+
+//==============================================================================
+/**
+*   @class  ImageNegationExpression
+*   @brief  Negative of an image, which preserves the dynamic of the image.
+*           The min and max values of the operand are computed when the
+*           expression is created, unless they are already known.
+*/
+//==============================================================================
+template <typename E>
+class ImageNegationExpression: public ImageExpression<ImageNegationExpression<E> >
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    explicit ImageNegationExpression(const E& anOperand):
+            m_operand(anOperand),
+            m_min_value(std::numeric_limits<double>::max()),
+            m_max_value(-std::numeric_limits<double>::max())
+    {
+        // The image is empty
+        if (!m_operand.getWidth() || !m_operand.getHeight())
+        {
+            throw "Empty image";
+        }
+
+        // Find the dynamic of the operand
+        for (unsigned int j(0); j < m_operand.getHeight(); ++j)
+        {
+            for (unsigned int i(0); i < m_operand.getWidth(); ++i)
+            {
+                double pixel_value(m_operand(i, j));
+                m_min_value = std::min(m_min_value, pixel_value);
+                m_max_value = std::max(m_max_value, pixel_value);
+            }
+        }
+    }
+
+
+    ImageNegationExpression(const E& anOperand, double aMinValue, double aMaxValue):
+            m_operand(anOperand),
+            m_min_value(aMinValue),
+            m_max_value(aMaxValue)
+    {}
+
+
+    unsigned int getWidth() const
+    {
+        return (m_operand.getWidth());
+    }
+
+
+    unsigned int getHeight() const
+    {
+        return (m_operand.getHeight());
+    }
+
+
+    double operator()(unsigned int i, unsigned int j) const
+    {
+        // Take care to preserve the dynamic of the image
+        double range(m_max_value - m_min_value);
+        return (m_min_value + range * (1.0 - (m_operand(i, j) - m_min_value) / range));
+    }
+
+
+    const E& getOperand() const
+    {
+        return (m_operand);
+    }
+
+
+    double getMinValue() const
+    {
+        return (m_min_value);
+    }
+
+
+    double getMaxValue() const
+    {
+        return (m_max_value);
+    }
+
+//******************************************************************************
+private:
+    /// The image operand
+    E m_operand;
+
+
+    /// The minimum pixel value of the operand
+    double m_min_value;
+
+
+    /// The maximum pixel value of the operand
+    double m_max_value;
+};
+
+
+//******************************************************************************
+//  Operators
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Addition operator. Add two images (images, views or expressions).
+/**
+* @param aLeft: the left-hand side image
+* @param aRight: the right-hand side image
+* @return the expression of the sum
+*/
+//------------------------------------------------------------------------
+template <typename L, typename R>
+typename std::enable_if<ImageOperand<L>::IS_OPERAND && ImageOperand<R>::IS_OPERAND,
+        ImageBinaryExpression<typename ImageOperand<L>::Type,
+                typename ImageOperand<R>::Type,
+                ImageAddition> >::type
+operator+(const L& aLeft, const R& aRight)
+{
+    return (ImageBinaryExpression<typename ImageOperand<L>::Type,
+            typename ImageOperand<R>::Type,
+            ImageAddition>(ImageOperand<L>::get(aLeft), ImageOperand<R>::get(aRight)));
+}
+
+
+//------------------------------------------------------------------------
+/// Subtraction operator. Subtract two images (images, views or expressions).
+/**
+* @param aLeft: the left-hand side image
+* @param aRight: the right-hand side image
+* @return the expression of the difference
+*/
+//------------------------------------------------------------------------
+template <typename L, typename R>
+typename std::enable_if<ImageOperand<L>::IS_OPERAND && ImageOperand<R>::IS_OPERAND,
+        ImageBinaryExpression<typename ImageOperand<L>::Type,
+                typename ImageOperand<R>::Type,
+                ImageSubtraction> >::type
+operator-(const L& aLeft, const R& aRight)
+{
+    return (ImageBinaryExpression<typename ImageOperand<L>::Type,
+            typename ImageOperand<R>::Type,
+            ImageSubtraction>(ImageOperand<L>::get(aLeft), ImageOperand<R>::get(aRight)));
+}
+
+
+//------------------------------------------------------------------------
+/// Addition operator. Add aValue to every pixel of the image
+/**
+* @param anImage: the image (image, view or expression)
+* @param aValue: the value to add
+* @return the expression of the sum
+*/
+//------------------------------------------------------------------------
+template <typename E>
+typename std::enable_if<ImageOperand<E>::IS_OPERAND,
+        ImageScalarExpression<typename ImageOperand<E>::Type, ImageAddition> >::type
+operator+(const E& anImage, double aValue)
+{
+    return (ImageScalarExpression<typename ImageOperand<E>::Type, ImageAddition>(
+            ImageOperand<E>::get(anImage), aValue));
+}
+
+
+//------------------------------------------------------------------------
+/// Subtraction operator. Subtract aValue to every pixel of the image
+/**
+* @param anImage: the image (image, view or expression)
+* @param aValue: the value to subtract
+* @return the expression of the difference
+*/
+//------------------------------------------------------------------------
+template <typename E>
+typename std::enable_if<ImageOperand<E>::IS_OPERAND,
+        ImageScalarExpression<typename ImageOperand<E>::Type, ImageSubtraction> >::type
+operator-(const E& anImage, double aValue)
+{
+    return (ImageScalarExpression<typename ImageOperand<E>::Type, ImageSubtraction>(
+            ImageOperand<E>::get(anImage), aValue));
+}
+
+
+//------------------------------------------------------------------------
+/// Multiplication operator. Multiply every pixel of the image by aValue
+/**
+* @param anImage: the image (image, view or expression)
+* @param aValue: the value to multiply
+* @return the expression of the product
+*/
+//------------------------------------------------------------------------
+template <typename E>
+typename std::enable_if<ImageOperand<E>::IS_OPERAND,
+        ImageScalarExpression<typename ImageOperand<E>::Type, ImageMultiplication> >::type
+operator*(const E& anImage, double aValue)
+{
+    return (ImageScalarExpression<typename ImageOperand<E>::Type, ImageMultiplication>(
+            ImageOperand<E>::get(anImage), aValue));
+}
+
+
+//------------------------------------------------------------------------
+/// Division operator. Divide every pixel of the image by aValue
+/**
+* @param anImage: the image (image, view or expression)
+* @param aValue: the value to divide
+* @return the expression of the quotient
+*/
+//------------------------------------------------------------------------
+template <typename E>
+typename std::enable_if<ImageOperand<E>::IS_OPERAND,
+        ImageScalarExpression<typename ImageOperand<E>::Type, ImageDivision> >::type
+operator/(const E& anImage, double aValue)
+{
+    // Division by zero
+    if (std::abs(aValue) < 1.0e-6)
+    {
+        throw "Division by zero.";
+    }
+
+    return (ImageScalarExpression<typename ImageOperand<E>::Type, ImageDivision>(
+            ImageOperand<E>::get(anImage), aValue));
+}
+
+
+//------------------------------------------------------------------------
+/// Negation operator. Compute the negative of the image.
+/**
+* @param anImage: the image (image, view or expression)
+* @return the expression of the negative
+*/
+//------------------------------------------------------------------------
+template <typename E>
+typename std::enable_if<ImageOperand<E>::IS_OPERAND,
+        ImageNegationExpression<typename ImageOperand<E>::Type> >::type
+operator!(const E& anImage)
+{
+    return (ImageNegationExpression<typename ImageOperand<E>::Type>(
+            ImageOperand<E>::get(anImage)));
+}
+
+
+//------------------------------------------------------------------------
+/// Negation of an image, which reuses the statistics stored in the image.
+/**
+* @param anImage: the image
+* @return the expression
+*/
+//------------------------------------------------------------------------
+template <typename T>
+ImageNegationExpression<BasicImageView<T> > operator!(const BasicImage<T>& anImage)
+{
+    return (ImageNegationExpression<BasicImageView<T> >(
+            anImage.getView(), anImage.getMinValue(), anImage.getMaxValue()));
+}
+
+#endif
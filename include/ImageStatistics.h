@@ -0,0 +1,104 @@
+#ifndef IMAGE_STATISTICS_H
+#define IMAGE_STATISTICS_H
+
+
+/**
+********************************************************************************
+*
+*   @file       ImageStatistics.h
+*
+*   @brief      Summary statistics of the pixels of an image.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <cmath> // Header file for sqrt
+
+
+//******************************************************************************
+//  Type definitions
+//******************************************************************************
+
+/// The statistics of a set of pixels, computed in a single pass
+struct ImageStatistics
+{
+    /// The number of pixels
+    unsigned int count;
+
+    /// The minimum pixel value
+    double min;
+
+    /// The maximum pixel value
+    double max;
+
+    /// The sum of the pixel values
+    double sum;
+
+    /// The average
+    double mean;
+
+    /// The (population) variance
+    double variance;
+
+    /// The standard deviation
+    double standardDeviation;
+};
+
+
+//------------------------------------------------------------------------
+/// Merge the statistics of two disjoint sets of pixels (Chan et al.).
+/// The variances are combined through the difference of the means, which
+/// is stable even when the means are large compared to the deviations.
+/**
+* @param aFirst: the statistics of the first set
+* @param aSecond: the statistics of the second set
+* @return the statistics of the union of the two sets
+*/
+//------------------------------------------------------------------------
+inline ImageStatistics mergeStatistics(const ImageStatistics& aFirst,
+                                       const ImageStatistics& aSecond)
+{
+    // One of the sets is empty
+    if (!aFirst.count)
+    {
+        return (aSecond);
+    }
+    if (!aSecond.count)
+    {
+        return (aFirst);
+    }
+
+    ImageStatistics statistics;
+    statistics.count = aFirst.count + aSecond.count;
+    statistics.min = aFirst.min < aSecond.min ? aFirst.min : aSecond.min;
+    statistics.max = aFirst.max > aSecond.max ? aFirst.max : aSecond.max;
+    statistics.sum = aFirst.sum + aSecond.sum;
+    statistics.mean = statistics.sum / statistics.count;
+
+    // Sum of the squared deviations of each set, plus the deviation of the means
+    double first_count(aFirst.count);
+    double second_count(aSecond.count);
+    double delta(aSecond.mean - aFirst.mean);
+    double squares(aFirst.variance * first_count + aSecond.variance * second_count +
+            delta * delta * first_count * second_count / statistics.count);
+
+    statistics.variance = squares / statistics.count;
+    statistics.standardDeviation = std::sqrt(statistics.variance);
+
+    return (statistics);
+}
+
+#endif
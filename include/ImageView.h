@@ -0,0 +1,565 @@
+#ifndef IMAGE_VIEW_H
+#define IMAGE_VIEW_H
+
+
+/**
+********************************************************************************
+*
+*   @file       ImageView.h
+*
+*   @brief      Class to access a region of a greyscale image without copy.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <vector>
+#include <cstdint>
+
+#include "Kernel.h"
+#include "BorderPolicy.h"
+#include "GradientOperator.h"
+#include "ImageStatistics.h"
+
+//******************************************************************************
+//  Forward declaration
+//******************************************************************************
+template <typename T> class BasicImage;
+
+//==============================================================================
+/**
+*   @class  BasicImageView
+*   @brief  BasicImageView is a read-only window on pixels owned by
+*           a BasicImage. It does not copy nor release the pixel data, so it
+*           must not outlive the image it was created from.
+*
+*   Rows are stride pixels apart in memory, which makes it possible to
+*   describe a region of interest (ROI) of a larger image.
+*/
+//==============================================================================
+template <typename T>
+class BasicImageView
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //--------------------------------------------------------------------------
+    /// Default constructor (empty view).
+    //--------------------------------------------------------------------------
+    BasicImageView();
+
+
+    //------------------------------------------------------------------------
+    /// Constructor.
+    /**
+    * @param apData: the first pixel of the view
+    * @param aWidth: the width of the view (in number of pixels)
+    * @param aHeight: the height of the view (in number of pixels)
+    * @param aStride: the distance between two rows (in number of pixels)
+    */
+    //------------------------------------------------------------------------
+    BasicImageView(const T* apData,
+                   unsigned int aWidth,
+                   unsigned int aHeight,
+                   unsigned int aStride);
+
+
+    //------------------------------------------------------------------------
+    /// Compute a region of interest (ROI) of the view, without copy.
+    /// The ROI is clipped to the view.
+    /**
+    * @param i: the position of the first pixel of the ROI along the horizontal axis
+    * @param j: the position of the first pixel of the ROI along the vertical axis
+    * @param aWidth: the width of the ROI (in number of pixels)
+    * @param aHeight: the height of the ROI (in number of pixels)
+    * @return the ROI
+    */
+    //------------------------------------------------------------------------
+    BasicImageView getROI(unsigned int i,
+            unsigned int j,
+            unsigned int aWidth,
+            unsigned int aHeight) const;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on a pixel value.
+    /**
+    * @param i: the position of the pixel along the horizontal axis
+    * @param j: the position of the pixel along the vertical axis
+    * @return the pixel value
+    */
+    //------------------------------------------------------------------------
+    T getPixel(unsigned int i, unsigned int j) const;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on a row of pixels.
+    /**
+    * @param j: the position of the row along the vertical axis
+    * @return the first pixel of the row
+    */
+    //------------------------------------------------------------------------
+    const T* getRow(unsigned int j) const;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on a pixel value, without any check. It is used to evaluate
+    /// the arithmetic expressions (see ImageExpression.h) and is defined here
+    /// so that it can be inlined.
+    /**
+    * @param i: the position of the pixel along the horizontal axis
+    * @param j: the position of the pixel along the vertical axis
+    * @return the pixel value
+    */
+    //------------------------------------------------------------------------
+    double operator()(unsigned int i, unsigned int j) const
+    {
+        return (m_p_data[j * m_stride + i]);
+    }
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the horizontal axis
+    /**
+    * @return the width
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWidth() const;
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the vertical axis
+    /**
+    * @return the height
+    */
+    //------------------------------------------------------------------------
+    unsigned int getHeight() const;
+
+
+    //------------------------------------------------------------------------
+    /// Distance between the first pixels of two consecutive rows
+    /**
+    * @return the stride (in number of pixels)
+    */
+    //------------------------------------------------------------------------
+    unsigned int getStride() const;
+
+
+    //------------------------------------------------------------------------
+    /// Check if the view is empty
+    /**
+    * @return true if the view has no pixel, false otherwise
+    */
+    //------------------------------------------------------------------------
+    bool isEmpty() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the min, max, sum, average, variance and standard deviation
+    /// of the pixels in a single pass.
+    /**
+    * @return the statistics of the view
+    */
+    //------------------------------------------------------------------------
+    ImageStatistics getStatistics() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the minimum pixel value in the view
+    /**
+    * @return the minimum pixel
+    */
+    //------------------------------------------------------------------------
+    double getMinValue() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the maximum pixel value in the view
+    /**
+    * @return the maximum pixel
+    */
+    //------------------------------------------------------------------------
+    double getMaxValue() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the sum of all the elements.
+    /**
+     * @return the sum of all the elements
+     */
+    //------------------------------------------------------------------------
+    double getSum() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the average.
+    /**
+     * @return the average
+     */
+    //------------------------------------------------------------------------
+    double getAverage() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the variance.
+    /**
+     * @return the variance
+     */
+    //------------------------------------------------------------------------
+    double getVariance() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the standard deviation.
+    /**
+     * @return the standard deviation
+     */
+    //------------------------------------------------------------------------
+    double getStandardDeviation() const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the sum of absolute errors (SAE) between two views.
+    /**
+     * @param aView: the view to use in the comparison
+     * @return the SAE
+     */
+    //------------------------------------------------------------------------
+    double computeSAE(const BasicImageView& aView) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the normalised-cross correlation (NCC) between two views.
+    /**
+     * @param aView: the view to use in the comparison
+     * @return the NCC
+     */
+    //------------------------------------------------------------------------
+    double computeNCC(const BasicImageView& aView) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convoultion of the view with provided kernel.
+    /// Pixels outside the view are replaced by the closest pixel of the view.
+    /// Separable (rank 1) kernels are applied as a row pass followed by
+    /// a column pass.
+    /**
+     * @param kernelArray: 3x3 kernel
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> convolution(const double kernelArray[]) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convoultion of the view with provided kernel, the result
+    /// is stored using the pixel type U (e.g. double to keep signed values).
+    /**
+     * @param kernelArray: 3x3 kernel
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    template <typename U>
+    BasicImage<U> convolve(const double kernelArray[]) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convoultion of the view with a kernel of any size.
+    /**
+     * @param aKernel: the kernel
+     * @param aMethod: how the convolution is carried out
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> convolution(const Kernel& aKernel,
+                              ConvolutionMethod aMethod = CONVOLUTION_AUTOMATIC,
+                              BorderPolicy aBorder = BORDER_CLAMP,
+                              double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convoultion of the view with a kernel of any size, the
+    /// result is stored using the pixel type U.
+    /**
+     * @param aKernel: the kernel
+     * @param aMethod: how the convolution is carried out
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    template <typename U>
+    BasicImage<U> convolve(const Kernel& aKernel,
+                           ConvolutionMethod aMethod = CONVOLUTION_AUTOMATIC,
+                           BorderPolicy aBorder = BORDER_CLAMP,
+                           double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the edge strength of the view with a 3x3 gradient operator.
+    /// Both derivatives are computed from a single read of every
+    /// neighbourhood, without any intermediate image. Gx increases from
+    /// left to right and Gy from top to bottom.
+    /**
+     * @param anOperator: the derivative kernels (Sobel or Prewitt)
+     * @param aMagnitude: how Gx and Gy are combined
+     * @param apOrientation: if not null, receives atan2(Gy, Gx) in radians
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return the gradient magnitude
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> gradient(GradientOperator anOperator = GRADIENT_SOBEL,
+                           GradientMagnitude aMagnitude = GRADIENT_L1,
+                           BasicImage<double>* apOrientation = 0,
+                           BorderPolicy aBorder = BORDER_CLAMP,
+                           double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Sharpen the view with an unsharp mask, in a single pass:
+    /// pixel + anAmount * (pixel - blur). The blur is a binomial kernel
+    /// (a Gaussian approximation, (1 2 1)/4 in each direction for a radius of 1).
+    /**
+     * @param anAmount: the weight of the detail added to the view
+     * @param aRadius: the radius of the blur
+     * @param aThreshold: the pixels whose detail (pixel - blur) is smaller
+     *                    than aThreshold in absolute value are not changed
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return the sharpened image
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> sharpen(double anAmount,
+                          unsigned int aRadius = 1,
+                          double aThreshold = 0.0,
+                          BorderPolicy aBorder = BORDER_CLAMP,
+                          double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the median filter to the view.
+    /**
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return image with median filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> medianFilter(BorderPolicy aBorder = BORDER_CLAMP,
+                               double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the median filter of a square window of any radius.
+    /// The cost per pixel does not depend on the radius for 8-bit images
+    /// (column histograms); 16-bit images use a sliding histogram and
+    /// floating-point images a sorted window.
+    /**
+     * @param aRadius: the radius of the window ((2 * aRadius + 1)^2 pixels)
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return image with median filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> medianFilter(unsigned int aRadius,
+                               BorderPolicy aBorder = BORDER_CLAMP,
+                               double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the mean filter of a square window of any radius. The sums
+    /// are read from an integral image, so the cost per pixel does not
+    /// depend on the radius.
+    /**
+     * @param aRadius: the radius of the window ((2 * aRadius + 1)^2 pixels)
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return image with mean filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> meanFilter(unsigned int aRadius,
+                             BorderPolicy aBorder = BORDER_CLAMP,
+                             double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the mean and the (population) variance of the square window
+    /// centred on each pixel, e.g. for adaptive thresholding. Both maps are
+    /// read from the same integral image.
+    /**
+     * @param aRadius: the radius of the window ((2 * aRadius + 1)^2 pixels)
+     * @param apMean: the local means (ignored if 0)
+     * @param apVariance: the local variances (ignored if 0)
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     */
+    //------------------------------------------------------------------------
+    void getLocalStatistics(unsigned int aRadius,
+                            BasicImage<double>* apMean,
+                            BasicImage<double>* apVariance,
+                            BorderPolicy aBorder = BORDER_CLAMP,
+                            double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the gaussian filter of any standard deviation. The recursive
+    /// filter of Young and van Vliet runs forward and backward along the
+    /// rows, then along the columns: the cost per pixel does not depend on
+    /// the standard deviation. The clamp and constant borders are exact
+    /// without padding; the reflect and wrap borders add a margin of
+    /// 4 sigma to each row and column. The recursive filter is within a few
+    /// percent of the peak of the gaussian; below 3 pixels, it is less
+    /// accurate and the (short) sampled kernel is used instead.
+    /**
+     * @param aSigma: the standard deviation of the gaussian (in pixels)
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     *                      (BORDER_CONSTANT only)
+     * @return image with gaussian filter applied
+     */
+    //------------------------------------------------------------------------
+    BasicImage<T> gaussianFilter(double aSigma,
+                                 BorderPolicy aBorder = BORDER_CLAMP,
+                                 double aBorderValue = 0.0) const;
+
+
+    //------------------------------------------------------------------------
+    /// Generated a histogram depending on the amount of bins the user wants
+    /// (the bins are evenly spaced between the min and the max, the max is
+    /// in the last bin)
+    /**
+     * @param aNumberOfBins: Number of bins to a histogram
+     * @return vector containing the amount of values in each bin
+     */
+    //------------------------------------------------------------------------
+    std::vector<unsigned int> getHistogram(unsigned int aNumberOfBins) const;
+
+
+    //------------------------------------------------------------------------
+    /// Generated a histogram with bins evenly spaced between given bounds
+    /// (the pixels outside the bounds are in the first or the last bin)
+    /**
+     * @param aNumberOfBins: Number of bins to a histogram
+     * @param aMinValue: the lower bound of the first bin
+     * @param aMaxValue: the upper bound of the last bin
+     * @return vector containing the amount of values in each bin
+     */
+    //------------------------------------------------------------------------
+    std::vector<unsigned int> getHistogram(unsigned int aNumberOfBins,
+                                           double aMinValue,
+                                           double aMaxValue) const;
+
+//******************************************************************************
+private:
+    //------------------------------------------------------------------------
+    /// Compute the convolution of the view with a separable kernel: a row
+    /// pass with the horizontal kernel, then a column pass with the vertical
+    /// kernel.
+    /**
+     * @param aHorizontalKernel: the row vector of the kernel
+     * @param aVerticalKernel: the column vector of the kernel
+     * @param anchorCol: the position of the anchor in the row vector
+     * @param anchorRow: the position of the anchor in the column vector
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    template <typename U>
+    BasicImage<U> convolveSeparable(const std::vector<double>& aHorizontalKernel,
+                                    const std::vector<double>& aVerticalKernel,
+                                    int anchorCol,
+                                    int anchorRow,
+                                    BorderPolicy aBorder,
+                                    double aBorderValue) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convolution as the product of the spectra of the view
+    /// (extended by the border policy) and of the kernel.
+    /**
+     * @param aKernel: the kernel
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     * @return image with provided kernel
+     */
+    //------------------------------------------------------------------------
+    template <typename U>
+    BasicImage<U> convolveFFT(const Kernel& aKernel,
+                              BorderPolicy aBorder,
+                              double aBorderValue) const;
+
+
+    //------------------------------------------------------------------------
+    /// Compute the convolution of a pixel close to the border of the view.
+    /**
+     * @param row: the row of the pixel
+     * @param col: the column of the pixel
+     * @param aKernel: the kernel
+     * @param aBorder: how the pixels outside the view are read
+     * @param aBorderValue: the value of the pixels outside the view
+     * @return the pixel value
+     */
+    //------------------------------------------------------------------------
+    double convolveBorderPixel(int row,
+                               int col,
+                               const Kernel& aKernel,
+                               BorderPolicy aBorder,
+                               double aBorderValue) const;
+
+
+    /// The first pixel of the view
+    const T* m_p_data;
+
+
+    /// Number of pixel along the horizontal axis
+    unsigned int m_width;
+
+
+    /// Number of pixel along the vertical axis
+    unsigned int m_height;
+
+
+    /// Number of pixel between two rows
+    unsigned int m_stride;
+};
+
+
+//******************************************************************************
+//  Pixel types
+//******************************************************************************
+
+/// View on an image using 8 bits per pixel
+typedef BasicImageView<std::uint8_t> ImageView8;
+
+/// View on an image using 16 bits per pixel
+typedef BasicImageView<std::uint16_t> ImageView16;
+
+/// View on an image using single precision floating-point pixels
+typedef BasicImageView<float> ImageViewF;
+
+/// View on an image using double precision floating-point pixels (default)
+typedef BasicImageView<double> ImageView;
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef INTEGRAL_IMAGE_H
+#define INTEGRAL_IMAGE_H
+
+
+/**
+********************************************************************************
+*
+*   @file       IntegralImage.h
+*
+*   @brief      Summed-area tables of an image, to compute the sum of the
+*               pixels of any rectangle in constant time.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <vector>
+
+#include "BorderPolicy.h"
+
+
+//******************************************************************************
+//  Class declarations
+//******************************************************************************
+template <typename T> class BasicImageView;
+
+
+//==============================================================================
+/**
+*   @class  IntegralImage
+*   @brief  IntegralImage is a class to store the summed-area tables of an
+*           image: the sum and the sum of the squares of the pixels above and
+*           at the left of each position. The sum of the pixels of any
+*           rectangle is then given by four values of a table.
+*
+*           The image can be extended by a margin that follows a border
+*           policy, so that windows centred on the pixels close to the border
+*           are rectangles of the tables too.
+*
+*           The tables are stored in double precision: the sums of integer
+*           pixels are exact up to 2^53.
+*/
+//==============================================================================
+class IntegralImage
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Default constructor, the tables are empty.
+    //------------------------------------------------------------------------
+    IntegralImage();
+
+
+    //------------------------------------------------------------------------
+    /// Constructor to build the tables of a view.
+    /**
+    * @param aView: the pixels
+    * @param aMargin: the number of pixels added on each side of the view
+    * @param aBorder: how the pixels of the margin are read
+    * @param aBorderValue: the value of the pixels of the margin
+    *                      (BORDER_CONSTANT only)
+    * @param aSquaredSums: true to build the table of the squared pixels too
+    */
+    //------------------------------------------------------------------------
+    template <typename T>
+    IntegralImage(const BasicImageView<T>& aView,
+                  unsigned int aMargin = 0,
+                  BorderPolicy aBorder = BORDER_CLAMP,
+                  double aBorderValue = 0.0,
+                  bool aSquaredSums = true);
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the horizontal axis of the view.
+    /**
+    * @return the width
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWidth() const;
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels along the vertical axis of the view.
+    /**
+    * @return the height
+    */
+    //------------------------------------------------------------------------
+    unsigned int getHeight() const;
+
+
+    //------------------------------------------------------------------------
+    /// Number of pixels added on each side of the view.
+    /**
+    * @return the margin
+    */
+    //------------------------------------------------------------------------
+    unsigned int getMargin() const;
+
+
+    //------------------------------------------------------------------------
+    /// Sum of the pixels of the rectangle [aLeft, aRight) x [aTop, aBottom).
+    /// The coordinates are the ones of the view, the rectangle may cover the
+    /// margin.
+    /**
+    * @param aLeft: the first column
+    * @param aTop: the first row
+    * @param aRight: the column after the last column
+    * @param aBottom: the row after the last row
+    * @return the sum of the pixels
+    */
+    //------------------------------------------------------------------------
+    double getSum(int aLeft, int aTop, int aRight, int aBottom) const;
+
+
+    //------------------------------------------------------------------------
+    /// Sum of the squared pixels of the rectangle [aLeft, aRight) x
+    /// [aTop, aBottom).
+    /**
+    * @param aLeft: the first column
+    * @param aTop: the first row
+    * @param aRight: the column after the last column
+    * @param aBottom: the row after the last row
+    * @return the sum of the squared pixels
+    */
+    //------------------------------------------------------------------------
+    double getSquaredSum(int aLeft, int aTop, int aRight, int aBottom) const;
+
+
+//******************************************************************************
+private:
+    //------------------------------------------------------------------------
+    /// Read the rectangle of a table.
+    /**
+    * @param aTable: the table
+    * @param aLeft: the first column
+    * @param aTop: the first row
+    * @param aRight: the column after the last column
+    * @param aBottom: the row after the last row
+    * @return the sum of the table over the rectangle
+    */
+    //------------------------------------------------------------------------
+    double getTableSum(const std::vector<double>& aTable,
+                       int aLeft, int aTop, int aRight, int aBottom) const;
+
+
+    /// Number of pixel along the horizontal axis of the view
+    unsigned int m_width;
+
+
+    /// Number of pixel along the vertical axis of the view
+    unsigned int m_height;
+
+
+    /// Number of pixels added on each side of the view
+    unsigned int m_margin;
+
+
+    /// Number of values between two rows of the tables
+    unsigned int m_stride;
+
+
+    /// Sums of the pixels, with a row and a column of zeros first
+    std::vector<double> m_sum_table;
+
+
+    /// Sums of the squared pixels (empty if they are not computed)
+    std::vector<double> m_squared_sum_table;
+};
+
+
+//---------------------------------------------------------------------------------------
+inline double IntegralImage::getTableSum(const std::vector<double>& aTable,
+                                         int aLeft, int aTop, int aRight, int aBottom) const
+//---------------------------------------------------------------------------------------
+{
+    int margin(m_margin);
+
+    // The rectangle is not in the tables
+    if (aLeft < -margin || aTop < -margin ||
+            aRight > int(m_width) + margin || aBottom > int(m_height) + margin ||
+            aLeft > aRight || aTop > aBottom)
+    {
+        throw "The rectangle is outside the integral image";
+    }
+
+    // Position in the tables
+    const double* p_top(&aTable[0] + (aTop + margin) * m_stride);
+    const double* p_bottom(&aTable[0] + (aBottom + margin) * m_stride);
+    unsigned int left(aLeft + margin);
+    unsigned int right(aRight + margin);
+
+    return (p_bottom[right] - p_bottom[left] - p_top[right] + p_top[left]);
+}
+
+
+//-------------------------------------------------------------------------------------
+inline double IntegralImage::getSum(int aLeft, int aTop, int aRight, int aBottom) const
+//-------------------------------------------------------------------------------------
+{
+    // The tables are empty
+    if (m_sum_table.empty())
+    {
+        throw "Integral image empty";
+    }
+
+    return (getTableSum(m_sum_table, aLeft, aTop, aRight, aBottom));
+}
+
+
+//--------------------------------------------------------------------------------------------
+inline double IntegralImage::getSquaredSum(int aLeft, int aTop, int aRight, int aBottom) const
+//--------------------------------------------------------------------------------------------
+{
+    // The squared pixels were not summed
+    if (m_squared_sum_table.empty())
+    {
+        throw "The squared sums are not computed";
+    }
+
+    return (getTableSum(m_squared_sum_table, aLeft, aTop, aRight, aBottom));
+}
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef KERNEL_H
+#define KERNEL_H
+
+
+/**
+********************************************************************************
+*
+*   @file       Kernel.h
+*
+*   @brief      Class to store a convolution kernel of any size.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <vector>
+
+//******************************************************************************
+//  Type definitions
+//******************************************************************************
+
+/// The way a convolution is carried out
+enum ConvolutionMethod
+{
+    /// Separable kernels use the separable method, non-separable kernels
+    /// larger than 15x15 the FFT method, others the direct method
+    CONVOLUTION_AUTOMATIC,
+
+    /// Direct 2D loop over the kernel coefficients
+    CONVOLUTION_DIRECT,
+
+    /// Row pass followed by a column pass (the kernel must be separable)
+    CONVOLUTION_SEPARABLE,
+
+    /// Product of the spectra of the image and of the kernel
+    CONVOLUTION_FFT
+};
+
+
+//==============================================================================
+/**
+*   @class  Kernel
+*   @brief  Kernel is a class to store the coefficients of a convolution
+*           kernel, row by row. The anchor is the coefficient applied to the
+*           pixel being computed (the centre of the kernel by default).
+*/
+//==============================================================================
+class Kernel
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor to build a null kernel.
+    /**
+    * @param aWidth: the width of the kernel
+    * @param aHeight: the height of the kernel
+    */
+    //------------------------------------------------------------------------
+    Kernel(unsigned int aWidth, unsigned int aHeight);
+
+
+    //------------------------------------------------------------------------
+    /// Constructor.
+    /**
+    * @param apData: the coefficients, row by row
+    * @param aWidth: the width of the kernel
+    * @param aHeight: the height of the kernel
+    */
+    //------------------------------------------------------------------------
+    Kernel(const double* apData, unsigned int aWidth, unsigned int aHeight);
+
+
+    //------------------------------------------------------------------------
+    /// Build a kernel from the 3x3 arrays used by BasicImage::convolution,
+    /// which are stored column by column.
+    /**
+    * @param kernelArray: 3x3 kernel
+    * @return the kernel
+    */
+    //------------------------------------------------------------------------
+    static Kernel fromArray3x3(const double kernelArray[]);
+
+
+    //------------------------------------------------------------------------
+    /// Build a normalised Gaussian kernel. Its radius is 3 sigma.
+    /**
+    * @param aSigma: the standard deviation (in pixels)
+    * @return the kernel
+    */
+    //------------------------------------------------------------------------
+    static Kernel gaussian(double aSigma);
+
+
+    //------------------------------------------------------------------------
+    /// Build a normalised mean (box) kernel.
+    /**
+    * @param aWidth: the width of the kernel
+    * @param aHeight: the height of the kernel
+    * @return the kernel
+    */
+    //------------------------------------------------------------------------
+    static Kernel mean(unsigned int aWidth, unsigned int aHeight);
+
+
+    //------------------------------------------------------------------------
+    /// Number of coefficients along the horizontal axis
+    /**
+    * @return the width
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWidth() const;
+
+
+    //------------------------------------------------------------------------
+    /// Number of coefficients along the vertical axis
+    /**
+    * @return the height
+    */
+    //------------------------------------------------------------------------
+    unsigned int getHeight() const;
+
+
+    //------------------------------------------------------------------------
+    /// Position of the anchor along the horizontal axis
+    /**
+    * @return the column of the anchor
+    */
+    //------------------------------------------------------------------------
+    unsigned int getAnchorX() const;
+
+
+    //------------------------------------------------------------------------
+    /// Position of the anchor along the vertical axis
+    /**
+    * @return the row of the anchor
+    */
+    //------------------------------------------------------------------------
+    unsigned int getAnchorY() const;
+
+
+    //------------------------------------------------------------------------
+    /// Set the anchor of the kernel.
+    /**
+    * @param i: the column of the anchor
+    * @param j: the row of the anchor
+    */
+    //------------------------------------------------------------------------
+    void setAnchor(unsigned int i, unsigned int j);
+
+
+    //------------------------------------------------------------------------
+    /// Set a coefficient of the kernel.
+    /**
+    * @param i: the column of the coefficient
+    * @param j: the row of the coefficient
+    * @param aValue: the new value
+    */
+    //------------------------------------------------------------------------
+    void setValue(unsigned int i, unsigned int j, double aValue);
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on a coefficient of the kernel.
+    /**
+    * @param i: the column of the coefficient
+    * @param j: the row of the coefficient
+    * @return the value
+    */
+    //------------------------------------------------------------------------
+    double getValue(unsigned int i, unsigned int j) const;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on the coefficients.
+    /**
+    * @return the coefficients, row by row
+    */
+    //------------------------------------------------------------------------
+    const double* getData() const;
+
+
+    //------------------------------------------------------------------------
+    /// Check if the kernel is separable (rank 1), i.e. if it is the product
+    /// of a column vector and a row vector, and compute these vectors.
+    /**
+    * @param aHorizontalKernel: the row vector (output)
+    * @param aVerticalKernel: the column vector (output)
+    * @return true if the kernel is separable, false otherwise
+    */
+    //------------------------------------------------------------------------
+    bool factorise(std::vector<double>& aHorizontalKernel,
+                   std::vector<double>& aVerticalKernel) const;
+
+//******************************************************************************
+private:
+    /// Number of coefficients along the horizontal axis
+    unsigned int m_width;
+
+
+    /// Number of coefficients along the vertical axis
+    unsigned int m_height;
+
+
+    /// Column of the anchor
+    unsigned int m_anchor_x;
+
+
+    /// Row of the anchor
+    unsigned int m_anchor_y;
+
+
+    /// The coefficients, row by row
+    std::vector<double> m_p_data;
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef LOOK_UP_TABLE_H
+#define LOOK_UP_TABLE_H
+
+
+/**
+********************************************************************************
+*
+*   @file       LookUpTable.h
+*
+*   @brief      Table of the values of a point operation for every pixel
+*               value of an integer image.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <vector>
+
+#include "PixelTraits.h"
+
+
+//==============================================================================
+/**
+*   @class  LookUpTable
+*   @brief  LookUpTable is a class to store the result of a chain of point
+*           operations for every value of an 8-bit or 16-bit pixel (256 or
+*           65536 entries). Each operation is applied to the table, with the
+*           same rounding and saturation as on an image, so applying the
+*           table gives the same pixels as applying the operations one after
+*           the other, in a single lookup per pixel.
+*
+*   T is std::uint8_t or std::uint16_t.
+*/
+//==============================================================================
+template <typename T>
+class LookUpTable
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Default constructor, the table is the identity.
+    //------------------------------------------------------------------------
+    LookUpTable();
+
+
+    //------------------------------------------------------------------------
+    /// Number of entries (the number of pixel values).
+    /**
+    * @return the size of the table
+    */
+    //------------------------------------------------------------------------
+    unsigned int getSize() const;
+
+
+    //------------------------------------------------------------------------
+    /// Access the entries.
+    /**
+    * @return the first entry
+    */
+    //------------------------------------------------------------------------
+    const T* getData() const;
+
+
+    //------------------------------------------------------------------------
+    /// Accessor on an entry.
+    /**
+    * @param aValue: the pixel value
+    * @return the value given by the operations
+    */
+    //------------------------------------------------------------------------
+    T operator[](unsigned int aValue) const;
+
+
+    //------------------------------------------------------------------------
+    /// Append the addition of a value.
+    /**
+    * @param aValue: the value to add
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& add(double aValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append the subtraction of a value.
+    /**
+    * @param aValue: the value to subtract
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& subtract(double aValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append the multiplication by a value.
+    /**
+    * @param aValue: the factor
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& multiply(double aValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append the division by a value.
+    /**
+    * @param aValue: the divisor
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& divide(double aValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append a shift followed by a scale: (value + aShiftValue) * aScaleValue.
+    /**
+    * @param aShiftValue: the value to add
+    * @param aScaleValue: the factor
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& shiftScale(double aShiftValue, double aScaleValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append the normalisation of a range of values between 0 and 1.
+    /**
+    * @param aMinValue: the value mapped to 0
+    * @param aMaxValue: the value mapped to 1
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& normalise(double aMinValue, double aMaxValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append the negative, which preserves a range of values (operator!).
+    /**
+    * @param aMinValue: the minimum value of the range
+    * @param aMaxValue: the maximum value of the range
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& negate(double aMinValue, double aMaxValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append a thresholding: 1 above the threshold, 0 otherwise.
+    /**
+    * @param aThresholdValue: the threshold
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& threshold(double aThresholdValue);
+
+
+    //------------------------------------------------------------------------
+    /// Append the operations of another table.
+    /**
+    * @param aTable: the table applied after this one
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    LookUpTable& append(const LookUpTable& aTable);
+
+
+    //------------------------------------------------------------------------
+    /// Append any point operation, computed in double precision.
+    /**
+    * @param aFunction: the operation, called with a pixel value
+    * @return the table
+    */
+    //------------------------------------------------------------------------
+    template <typename F>
+    LookUpTable& append(F aFunction)
+    {
+        for (unsigned int i(0); i < getSize(); ++i)
+        {
+            m_entry_set[i] = PixelTraits<T>::fromDouble(aFunction(double(m_entry_set[i])));
+        }
+
+        return (*this);
+    }
+
+
+    //------------------------------------------------------------------------
+    /// Map pixels through the table. The implementation of 16-bit pixels
+    /// (AVX2 gathers or plain C++) is selected at runtime depending on the
+    /// CPU. 8-bit pixels use plain C++.
+    /**
+    * @param apInput: the pixels
+    * @param apOutput: the mapped pixels (it can be apInput)
+    * @param aLength: the number of pixels
+    */
+    //------------------------------------------------------------------------
+    void apply(const T* apInput, T* apOutput, unsigned int aLength) const;
+
+
+//******************************************************************************
+private:
+    /// The value of each pixel value, followed by an unused entry so that
+    /// the gathers can read 32 bits from the last entry
+    std::vector<T> m_entry_set;
+};
+
+#endif
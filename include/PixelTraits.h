@@ -0,0 +1,76 @@
+#ifndef PIXEL_TRAITS_H
+#define PIXEL_TRAITS_H
+
+
+/**
+********************************************************************************
+*
+*   @file       PixelTraits.h
+*
+*   @brief      Properties of the types used to store the pixels of an image.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <limits>
+#include <cmath>
+
+//==============================================================================
+/**
+*   @class  PixelTraits
+*   @brief  PixelTraits describes the type T used to store a pixel and
+*           converts double precision values into T.
+*/
+//==============================================================================
+template <typename T>
+struct PixelTraits
+//------------------------------------------------------------------------------
+{
+    /// True if T is an integer type
+    static const bool IS_INTEGER = std::numeric_limits<T>::is_integer;
+
+
+    //------------------------------------------------------------------------
+    /// Convert a double precision value into a pixel value. Integer types
+    /// are rounded to the nearest value and saturated to their range.
+    /**
+    * @param aValue: the value to convert
+    * @return the pixel value
+    */
+    //------------------------------------------------------------------------
+    static T fromDouble(double aValue)
+    {
+        // Floating-point pixel
+        if (!IS_INTEGER)
+        {
+            return (static_cast<T>(aValue));
+        }
+
+        // Saturate (NaN is mapped to the lowest value)
+        if (!(aValue > double(std::numeric_limits<T>::min())))
+        {
+            return (std::numeric_limits<T>::min());
+        }
+        else if (aValue >= double(std::numeric_limits<T>::max()))
+        {
+            return (std::numeric_limits<T>::max());
+        }
+
+        // Round to the nearest integer
+        return (static_cast<T>(std::floor(aValue + 0.5)));
+    }
+};
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef RECURSIVE_GAUSSIAN_H
+#define RECURSIVE_GAUSSIAN_H
+
+
+/**
+********************************************************************************
+*
+*   @file       RecursiveGaussian.h
+*
+*   @brief      Recursive (IIR) approximation of the Gaussian filter, whose
+*               cost per sample does not depend on the standard deviation.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//==============================================================================
+/**
+*   @class  RecursiveGaussian
+*   @brief  RecursiveGaussian is a class to filter 1D signals with the
+*           third-order recursive filter of Young and van Vliet, run forward
+*           then backward. The backward pass starts from the exact state of
+*           an input that is constant after the last sample (Triggs and
+*           Sdika), so the borders do not need any padding.
+*
+*           Several signals of the same length (lanes) are filtered at once:
+*           sample n of lane l is at position n * lanes + l. A column pass
+*           over a band of columns then reads whole rows.
+*/
+//==============================================================================
+class RecursiveGaussian
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor.
+    /**
+    * @param aSigma: the standard deviation (in samples), at least
+    *                getMinimumSigma()
+    */
+    //------------------------------------------------------------------------
+    explicit RecursiveGaussian(double aSigma);
+
+
+    //------------------------------------------------------------------------
+    /// Filter signals in place.
+    /**
+    * @param apData: the samples, aLength * aNumberOfLanes values
+    * @param aLength: the number of samples of each signal
+    * @param aNumberOfLanes: the number of signals
+    * @param apBefore: for each lane, the value of the samples before the
+    *                  first one
+    * @param apAfter: for each lane, the value of the samples after the
+    *                 last one
+    */
+    //------------------------------------------------------------------------
+    void filter(double* apData,
+                unsigned int aLength,
+                unsigned int aNumberOfLanes,
+                const double* apBefore,
+                const double* apAfter) const;
+
+
+    //------------------------------------------------------------------------
+    /// The smallest standard deviation approximated by the recursive filter.
+    /**
+    * @return the smallest standard deviation
+    */
+    //------------------------------------------------------------------------
+    static double getMinimumSigma();
+
+
+//******************************************************************************
+private:
+    /// The gain of the input
+    double m_b;
+
+
+    /// The feedback coefficients of the previous 3 outputs
+    double m_a[3];
+
+
+    /// The deviations of the first 3 outputs of the backward pass, from the
+    /// deviations of the last 3 outputs of the forward pass
+    double m_m[3][3];
+};
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+
+/**
+********************************************************************************
+*
+*   @file       Spectrum.h
+*
+*   @brief      Discrete Fourier transform of a real image, to filter it in
+*               the frequency domain.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <vector>
+
+#include "FFT.h"
+
+
+//******************************************************************************
+//  Class declarations
+//******************************************************************************
+template <typename T> class BasicImage;
+template <typename T> class BasicImageView;
+
+
+//==============================================================================
+/**
+*   @class  Spectrum
+*   @brief  Spectrum is a class to store the discrete Fourier transform of a
+*           real image, padded with zeros to a given size. The transform of a
+*           real image is Hermitian, so only the columns 0 to width / 2 are
+*           stored.
+*
+*           The product of two spectra of the same size is the circular
+*           convolution of the images (or their circular correlation when
+*           the second spectrum is conjugated), and their quotient undoes a
+*           convolution (deblurring). Pad both images to at least the sum of
+*           their sizes minus one to avoid the wrap-around.
+*/
+//==============================================================================
+class Spectrum
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor to compute the spectrum of a view.
+    /**
+    * @param aView: the pixels
+    * @param aWidth: the width of the transform, at least the width of the
+    *                view (0 for the width of the view). getFFTSize gives
+    *                the fastest sizes.
+    * @param aHeight: the height of the transform, at least the height of
+    *                 the view (0 for the height of the view)
+    */
+    //------------------------------------------------------------------------
+    template <typename T>
+    explicit Spectrum(const BasicImageView<T>& aView,
+                      unsigned int aWidth = 0,
+                      unsigned int aHeight = 0);
+
+
+    //------------------------------------------------------------------------
+    /// Width of the transform.
+    /**
+    * @return the width
+    */
+    //------------------------------------------------------------------------
+    unsigned int getWidth() const;
+
+
+    //------------------------------------------------------------------------
+    /// Height of the transform.
+    /**
+    * @return the height
+    */
+    //------------------------------------------------------------------------
+    unsigned int getHeight() const;
+
+
+    //------------------------------------------------------------------------
+    /// Access the coefficients of a row: getWidth() / 2 + 1 frequencies.
+    /**
+    * @param j: the row (vertical frequency)
+    * @return the first coefficient of the row
+    */
+    //------------------------------------------------------------------------
+    Complex* getRow(unsigned int j);
+
+
+    //------------------------------------------------------------------------
+    /// Access the coefficients of a row: getWidth() / 2 + 1 frequencies.
+    /**
+    * @param j: the row (vertical frequency)
+    * @return the first coefficient of the row
+    */
+    //------------------------------------------------------------------------
+    const Complex* getRow(unsigned int j) const;
+
+
+    //------------------------------------------------------------------------
+    /// Multiply the spectrum by another one, coefficient by coefficient.
+    /**
+    * @param aSpectrum: the other spectrum, of the same size
+    * @param aConjugate: true to multiply by the conjugate of the other
+    *                    spectrum (correlation instead of convolution)
+    * @return the spectrum
+    */
+    //------------------------------------------------------------------------
+    Spectrum& multiply(const Spectrum& aSpectrum, bool aConjugate = false);
+
+
+    //------------------------------------------------------------------------
+    /// Divide the spectrum by another one, coefficient by coefficient, with
+    /// a Wiener-like regularisation: X * conj(K) / (|K|^2 + aRegularisation).
+    /// Dividing the spectrum of a blurred image by the spectrum of the blur
+    /// kernel deblurs it.
+    /**
+    * @param aSpectrum: the other spectrum, of the same size
+    * @param aRegularisation: added to the squared magnitude of the other
+    *                         spectrum, to limit the gain where it is small
+    * @return the spectrum
+    */
+    //------------------------------------------------------------------------
+    Spectrum& divide(const Spectrum& aSpectrum, double aRegularisation);
+
+
+    //------------------------------------------------------------------------
+    /// Compute the inverse transform.
+    /**
+    * @return the image, of the size of the transform
+    */
+    //------------------------------------------------------------------------
+    BasicImage<double> inverse() const;
+
+
+//******************************************************************************
+private:
+    //------------------------------------------------------------------------
+    /// Check that another spectrum has the same size.
+    /**
+    * @param aSpectrum: the other spectrum
+    */
+    //------------------------------------------------------------------------
+    void checkSize(const Spectrum& aSpectrum) const;
+
+
+    /// Width of the transform
+    unsigned int m_width;
+
+
+    /// Height of the transform
+    unsigned int m_height;
+
+
+    /// Number of coefficients in a row (m_width / 2 + 1)
+    unsigned int m_half_width;
+
+
+    /// The coefficients, row by row
+    std::vector<Complex> m_coefficient_set;
+};
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+
+/**
+********************************************************************************
+*
+*   @file       ThreadPool.h
+*
+*   @brief      Pool of worker threads to process images by bands of rows.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//******************************************************************************
+//  Define
+//******************************************************************************
+/// Environment variable giving the default number of threads
+#define IMAGE_NUM_THREADS_VARIABLE "IMAGE_NUM_THREADS"
+
+
+/// Task run on a range of rows [first, last)
+typedef std::function<void (unsigned int, unsigned int)> RowTask;
+
+
+//==============================================================================
+/**
+*   @class  ThreadPool
+*   @brief  ThreadPool is a class to run a task over a range of rows with a
+*           fixed set of worker threads. The range is split into contiguous
+*           bands, so every thread works on neighbouring rows (the halo rows
+*           read by a neighbourhood filter are shared with the next band
+*           only). The calling thread processes bands too.
+*
+*           Every row must be computed independently of the band it
+*           belongs to, so that the result does not depend on the number
+*           of threads.
+*/
+//==============================================================================
+class ThreadPool
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor.
+    /**
+    * @param aNumberOfThreads: the number of threads, including the calling
+    *                          thread (0 for the number of cores)
+    */
+    //------------------------------------------------------------------------
+    explicit ThreadPool(unsigned int aNumberOfThreads);
+
+
+    //------------------------------------------------------------------------
+    /// Destructor, the worker threads are stopped.
+    //------------------------------------------------------------------------
+    ~ThreadPool();
+
+
+    //------------------------------------------------------------------------
+    /// Number of threads, including the calling thread.
+    /**
+    * @return the number of threads
+    */
+    //------------------------------------------------------------------------
+    unsigned int getNumberOfThreads() const;
+
+
+    //------------------------------------------------------------------------
+    /// Run a task over the rows [aBegin, aEnd), split in bands. The call
+    /// returns when every band has been processed. A call from a task runs
+    /// the whole range in the current thread. If a band throws, the other
+    /// bands are still processed and the first error is rethrown.
+    /**
+    * @param aBegin: the first row
+    * @param aEnd: the row after the last row
+    * @param aTask: the task, called with the range of each band
+    */
+    //------------------------------------------------------------------------
+    void parallelFor(unsigned int aBegin, unsigned int aEnd, const RowTask& aTask);
+
+
+    //------------------------------------------------------------------------
+    /// The pool shared by the image filters. It is created on first use with
+    /// the number of threads given by the IMAGE_NUM_THREADS environment
+    /// variable (all the cores if it is not set).
+    /**
+    * @return the pool
+    */
+    //------------------------------------------------------------------------
+    static ThreadPool& getInstance();
+
+
+    //------------------------------------------------------------------------
+    /// Change the number of threads of the shared pool. This must not be
+    /// called while a filter is running.
+    /**
+    * @param aNumberOfThreads: the number of threads (0 for the number of cores)
+    */
+    //------------------------------------------------------------------------
+    static void setNumberOfThreads(unsigned int aNumberOfThreads);
+
+
+    //------------------------------------------------------------------------
+    /// Number of threads used when none is specified.
+    /**
+    * @return the value of IMAGE_NUM_THREADS, or the number of cores
+    */
+    //------------------------------------------------------------------------
+    static unsigned int getDefaultNumberOfThreads();
+
+
+//******************************************************************************
+private:
+    /// The worker threads
+    std::vector<std::thread> m_p_thread_set;
+
+
+    /// Serialise the jobs posted by different threads
+    std::mutex m_job_mutex;
+
+
+    /// Protect the job below
+    std::mutex m_mutex;
+
+
+    /// Wake up the workers when a job is posted
+    std::condition_variable m_job_condition;
+
+
+    /// Wake up the calling thread when the job is finished
+    std::condition_variable m_done_condition;
+
+
+    /// The task of the current job
+    const RowTask* m_p_task;
+
+
+    /// The range of the current job
+    unsigned int m_begin;
+    unsigned int m_end;
+
+
+    /// The number of bands of the current job
+    unsigned int m_number_of_bands;
+
+
+    /// The next band to process
+    std::atomic<unsigned int> m_next_band;
+
+
+    /// The number of bands processed
+    unsigned int m_finished_bands;
+
+
+    /// The first error thrown by a band of the current job
+    std::exception_ptr m_p_error;
+
+
+    /// The number of workers processing bands of the current job
+    unsigned int m_active_workers;
+
+
+    /// Incremented for every job, the workers wait for a new value
+    unsigned int m_job_id;
+
+
+    /// True when the workers must stop
+    bool m_stop;
+
+
+    //------------------------------------------------------------------------
+    /// Loop of the worker threads.
+    //------------------------------------------------------------------------
+    void runWorker();
+
+
+    //------------------------------------------------------------------------
+    /// Process bands of the current job until there is none left.
+    /**
+    * @return the number of bands processed
+    */
+    //------------------------------------------------------------------------
+    unsigned int processBands();
+
+
+    ThreadPool(const ThreadPool&);
+    ThreadPool& operator=(const ThreadPool&);
+};
+
+
+//==============================================================================
+/**
+*   @class  SerialRegion
+*   @brief  While a SerialRegion exists, the filters called by the current
+*           thread run in this thread only. It is used by tasks that are
+*           already run concurrently (see BatchScheduler).
+*/
+//==============================================================================
+class SerialRegion
+//------------------------------------------------------------------------------
+{
+//******************************************************************************
+public:
+    //------------------------------------------------------------------------
+    /// Constructor, the filters of the current thread become serial.
+    //------------------------------------------------------------------------
+    SerialRegion();
+
+
+    //------------------------------------------------------------------------
+    /// Destructor, the previous behaviour is restored.
+    //------------------------------------------------------------------------
+    ~SerialRegion();
+
+
+//******************************************************************************
+private:
+    /// True if the filters were already serial
+    bool m_was_serial;
+
+
+    SerialRegion(const SerialRegion&);
+    SerialRegion& operator=(const SerialRegion&);
+};
+
+
+//------------------------------------------------------------------------
+/// Run a task over the rows [0, aHeight) with the shared pool.
+/**
+* @param aHeight: the number of rows
+* @param aTask: the task, called with the range of each band
+*/
+//------------------------------------------------------------------------
+inline void parallelForRows(unsigned int aHeight, const RowTask& aTask)
+{
+    ThreadPool::getInstance().parallelFor(0, aHeight, aTask);
+}
+
+#endif
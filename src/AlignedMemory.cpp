@@ -0,0 +1,73 @@
+/**
+********************************************************************************
+*
+*   @file       AlignedMemory.cpp
+*
+*   @brief      Allocation of memory blocks aligned on cache lines.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#ifdef _WIN32
+#include <malloc.h> // Header file for _aligned_malloc
+#else
+#include <stdlib.h> // Header file for posix_memalign
+#endif
+
+#include "AlignedMemory.h"
+
+
+//------------------------------------------
+void* allocateAligned(std::size_t aSize)
+//------------------------------------------
+{
+    // There is nothing to allocate
+    if (!aSize)
+    {
+        return (0);
+    }
+
+    void* p_data(0);
+
+#ifdef _WIN32
+    p_data = _aligned_malloc(aSize, MEMORY_ALIGNMENT);
+#else
+    if (posix_memalign(&p_data, MEMORY_ALIGNMENT, aSize))
+    {
+        p_data = 0;
+    }
+#endif
+
+    // Out of memory
+    if (!p_data)
+    {
+        throw "Out of memory";
+    }
+
+    return (p_data);
+}
+
+
+//----------------------------------
+void releaseAligned(void* apData)
+//----------------------------------
+{
+#ifdef _WIN32
+    _aligned_free(apData);
+#else
+    free(apData);
+#endif
+}
@@ -0,0 +1,276 @@
+/**
+********************************************************************************
+*
+*   @file       BatchScheduler.cpp
+*
+*   @brief      Work-stealing scheduler to run many independent image jobs.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include "BatchScheduler.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local variables
+//******************************************************************************
+
+/// True in the threads that run the tasks of a batch
+static thread_local bool g_in_batch(false);
+
+
+//---------------------------------------------------------------
+BatchScheduler::BatchScheduler(unsigned int aNumberOfThreads):
+//---------------------------------------------------------------
+        m_p_task_set(0),
+        m_active_workers(0),
+        m_batch_id(0),
+        m_stop(false)
+//---------------------------------------------------------------
+{
+    if (!aNumberOfThreads)
+    {
+        aNumberOfThreads = ThreadPool::getDefaultNumberOfThreads();
+    }
+
+    m_p_queue_set.reset(new WorkQueue[aNumberOfThreads]);
+
+    // The calling thread is one of the threads and uses the first queue
+    for (unsigned int i(1); i < aNumberOfThreads; ++i)
+    {
+        m_p_thread_set.push_back(std::thread(&BatchScheduler::runWorker, this, i));
+    }
+}
+
+
+//--------------------------------
+BatchScheduler::~BatchScheduler()
+//--------------------------------
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_batch_condition.notify_all();
+
+    for (std::vector<std::thread>::iterator ite(m_p_thread_set.begin());
+            ite != m_p_thread_set.end();
+            ++ite)
+    {
+        ite->join();
+    }
+}
+
+
+//-------------------------------------------------------
+unsigned int BatchScheduler::getNumberOfThreads() const
+//-------------------------------------------------------
+{
+    return (m_p_thread_set.size() + 1);
+}
+
+
+//-------------------------------------------------------------
+void BatchScheduler::run(const std::vector<BatchTask>& aTaskSet)
+//-------------------------------------------------------------
+{
+    // Nothing to do
+    if (aTaskSet.empty())
+    {
+        return;
+    }
+
+    // Nested call, single thread or single task: run in the current thread
+    // (the filters of a single task may use the thread pool instead)
+    if (g_in_batch || m_p_thread_set.empty() || aTaskSet.size() == 1)
+    {
+        std::exception_ptr p_error;
+        for (unsigned int i(0); i < aTaskSet.size(); ++i)
+        {
+            try
+            {
+                aTaskSet[i]();
+            }
+            catch (...)
+            {
+                if (!p_error)
+                {
+                    p_error = std::current_exception();
+                }
+            }
+        }
+
+        if (p_error)
+        {
+            std::rethrow_exception(p_error);
+        }
+        return;
+    }
+
+    // Batches posted by different threads are processed one after the other
+    std::lock_guard<std::mutex> batch_lock(m_batch_mutex);
+
+    // Post the batch
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // The workers that joined the previous batch must have left it
+        m_done_condition.wait(lock, [this]() { return (m_active_workers == 0); });
+
+        m_p_task_set = &aTaskSet;
+        m_error_set.assign(aTaskSet.size(), std::exception_ptr());
+
+        // Deal the tasks to the queues
+        unsigned int number_of_queues(getNumberOfThreads());
+        for (unsigned int i(0); i < aTaskSet.size(); ++i)
+        {
+            WorkQueue& queue(m_p_queue_set[i % number_of_queues]);
+            std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            queue.task_set.push_back(i);
+        }
+
+        ++m_batch_id;
+    }
+    m_batch_condition.notify_all();
+
+    // Take part in the batch
+    processQueues(0);
+
+    // Every queue is empty, wait for the tasks still running
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_condition.wait(lock, [this]() { return (m_active_workers == 0); });
+    m_p_task_set = 0;
+
+    // Report the first error
+    for (unsigned int i(0); i < m_error_set.size(); ++i)
+    {
+        if (m_error_set[i])
+        {
+            std::exception_ptr p_error(m_error_set[i]);
+            m_error_set.clear();
+            std::rethrow_exception(p_error);
+        }
+    }
+    m_error_set.clear();
+}
+
+
+//-----------------------------------------------
+BatchScheduler& BatchScheduler::getInstance()
+//-----------------------------------------------
+{
+    static BatchScheduler scheduler(0);
+    return (scheduler);
+}
+
+
+//------------------------------------------------------------
+void BatchScheduler::runWorker(unsigned int aQueueIndex)
+//------------------------------------------------------------
+{
+    unsigned int last_batch_id(0);
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_batch_condition.wait(lock, [&]() { return (m_stop || m_batch_id != last_batch_id); });
+
+        // The scheduler is destroyed
+        if (m_stop)
+        {
+            return;
+        }
+
+        last_batch_id = m_batch_id;
+        ++m_active_workers;
+        lock.unlock();
+
+        processQueues(aQueueIndex);
+
+        lock.lock();
+        --m_active_workers;
+        if (!m_active_workers)
+        {
+            m_done_condition.notify_all();
+        }
+    }
+}
+
+
+//------------------------------------------------------------
+void BatchScheduler::processQueues(unsigned int aQueueIndex)
+//------------------------------------------------------------
+{
+    // The filters called by the tasks run in this thread
+    g_in_batch = true;
+    SerialRegion serial_region;
+
+    unsigned int number_of_queues(getNumberOfThreads());
+    while (true)
+    {
+        bool found(false);
+        unsigned int task_index(0);
+
+        // Take the oldest task of the own queue first, then steal the
+        // newest task of the next non-empty queue
+        for (unsigned int k(0); k < number_of_queues && !found; ++k)
+        {
+            WorkQueue& queue(m_p_queue_set[(aQueueIndex + k) % number_of_queues]);
+            std::lock_guard<std::mutex> queue_lock(queue.mutex);
+            if (!queue.task_set.empty())
+            {
+                if (!k)
+                {
+                    task_index = queue.task_set.front();
+                    queue.task_set.pop_front();
+                }
+                else
+                {
+                    task_index = queue.task_set.back();
+                    queue.task_set.pop_back();
+                }
+                found = true;
+            }
+        }
+
+        // No task is left: the tasks are never added during a batch
+        if (!found)
+        {
+            break;
+        }
+
+        runTask(task_index);
+    }
+
+    g_in_batch = false;
+}
+
+
+//------------------------------------------------------
+void BatchScheduler::runTask(unsigned int aTaskIndex)
+//------------------------------------------------------
+{
+    try
+    {
+        (*m_p_task_set)[aTaskIndex]();
+    }
+    catch (...)
+    {
+        // Each task has its own slot, no lock is needed
+        m_error_set[aTaskIndex] = std::current_exception();
+    }
+}
@@ -0,0 +1,465 @@
+/**
+********************************************************************************
+*
+*   @file       BinaryImage.cpp
+*
+*   @brief      Binary image (mask) packed at one bit per pixel.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h> // Header file for SSE2 intrinsics
+#define BINARY_IMAGE_HAS_SSE2
+#endif
+
+#include <algorithm> // Header file for min
+#include <cmath> // Header file for floor/nextafter
+
+#include "BinaryImage.h"
+#include "Image.h"
+#include "ImageView.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Number of bits set in a word.
+/**
+* @param aWord: the word
+* @return the number of bits set
+*/
+//------------------------------------------------------------------------
+static inline unsigned int countBits(std::uint64_t aWord)
+//------------------------------------------------------------------------
+{
+#if defined(__GNUC__)
+    return (__builtin_popcountll(aWord));
+#else
+    // Sums of the bits by pairs, nibbles, then bytes
+    aWord -= (aWord >> 1) & 0x5555555555555555ULL;
+    aWord = (aWord & 0x3333333333333333ULL) + ((aWord >> 2) & 0x3333333333333333ULL);
+    aWord = (aWord + (aWord >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return ((aWord * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+
+//------------------------------------------------------------------------
+/// Threshold the pixels of a row, starting at a given pixel, into a word.
+/**
+* @param apInput: the row
+* @param aFirst: the first pixel
+* @param aLast: the pixel after the last pixel (at most aFirst + 64)
+* @param aThresholdValue: the threshold
+* @return the word
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static std::uint64_t thresholdWord(const T* apInput,
+                                   unsigned int aFirst,
+                                   unsigned int aLast,
+                                   double aThresholdValue)
+//------------------------------------------------------------------------
+{
+    std::uint64_t word(0);
+    for (unsigned int i(aFirst); i < aLast; ++i)
+    {
+        if (double(apInput[i]) > aThresholdValue)
+        {
+            word |= std::uint64_t(1) << (i - aFirst);
+        }
+    }
+
+    return (word);
+}
+
+
+//------------------------------------------------------------------------
+/// Threshold a row of pixels.
+/**
+* @param apInput: the row
+* @param aWidth: the number of pixels
+* @param aThresholdValue: the threshold
+* @param apOutput: the words of the row
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static void thresholdRow(const T* apInput,
+                         unsigned int aWidth,
+                         double aThresholdValue,
+                         std::uint64_t* apOutput)
+//------------------------------------------------------------------------
+{
+    for (unsigned int i(0); i < aWidth; i += 64)
+    {
+        apOutput[i / 64] = thresholdWord(apInput, i, std::min(i + 64, aWidth), aThresholdValue);
+    }
+}
+
+
+#ifdef BINARY_IMAGE_HAS_SSE2
+//------------------------------------------------------------------------
+/// Threshold a row of pixels with SSE2: the comparisons of 2, 4 or 16
+/// pixels give their bits at once.
+/**
+* @param apInput: the row
+* @param aWidth: the number of pixels
+* @param aThresholdValue: the threshold
+* @param apOutput: the words of the row
+*/
+//------------------------------------------------------------------------
+static void thresholdRow(const double* apInput,
+                         unsigned int aWidth,
+                         double aThresholdValue,
+                         std::uint64_t* apOutput)
+//------------------------------------------------------------------------
+{
+    __m128d threshold(_mm_set1_pd(aThresholdValue));
+    unsigned int i(0);
+
+    // 64 pixels, 2 at a time
+    for (; i + 64 <= aWidth; i += 64)
+    {
+        std::uint64_t word(0);
+        for (unsigned int k(0); k < 64; k += 2)
+        {
+            __m128d above(_mm_cmpgt_pd(_mm_loadu_pd(apInput + i + k), threshold));
+            word |= std::uint64_t(_mm_movemask_pd(above)) << k;
+        }
+
+        apOutput[i / 64] = word;
+    }
+
+    if (i < aWidth)
+    {
+        apOutput[i / 64] = thresholdWord(apInput, i, aWidth, aThresholdValue);
+    }
+}
+
+
+static void thresholdRow(const float* apInput,
+                         unsigned int aWidth,
+                         double aThresholdValue,
+                         std::uint64_t* apOutput)
+//------------------------------------------------------------------------
+{
+    // The largest float not above the threshold gives the same comparisons
+    float floatThreshold(aThresholdValue);
+    if (double(floatThreshold) > aThresholdValue)
+    {
+        floatThreshold = std::nextafter(floatThreshold, -HUGE_VALF);
+    }
+
+    __m128 threshold(_mm_set1_ps(floatThreshold));
+    unsigned int i(0);
+
+    // 64 pixels, 4 at a time
+    for (; i + 64 <= aWidth; i += 64)
+    {
+        std::uint64_t word(0);
+        for (unsigned int k(0); k < 64; k += 4)
+        {
+            __m128 above(_mm_cmpgt_ps(_mm_loadu_ps(apInput + i + k), threshold));
+            word |= std::uint64_t(_mm_movemask_ps(above)) << k;
+        }
+
+        apOutput[i / 64] = word;
+    }
+
+    if (i < aWidth)
+    {
+        apOutput[i / 64] = thresholdWord(apInput, i, aWidth, aThresholdValue);
+    }
+}
+
+
+static void thresholdRow(const std::uint8_t* apInput,
+                         unsigned int aWidth,
+                         double aThresholdValue,
+                         std::uint64_t* apOutput)
+//------------------------------------------------------------------------
+{
+    // No pixel is above the threshold, the row stays 0
+    if (!(aThresholdValue < 255.0))
+    {
+        return;
+    }
+
+    // x > threshold if and only if max(x, lowest) == x, where lowest is the
+    // smallest integer above the threshold
+    int lowest(aThresholdValue < 0.0 ? 0 : int(std::floor(aThresholdValue)) + 1);
+    __m128i threshold(_mm_set1_epi8(char(lowest)));
+    unsigned int i(0);
+
+    // 64 pixels, 16 at a time
+    for (; i + 64 <= aWidth; i += 64)
+    {
+        std::uint64_t word(0);
+        for (unsigned int k(0); k < 64; k += 16)
+        {
+            __m128i pixels(_mm_loadu_si128(reinterpret_cast<const __m128i*>(apInput + i + k)));
+            __m128i above(_mm_cmpeq_epi8(_mm_max_epu8(pixels, threshold), pixels));
+            word |= std::uint64_t(unsigned(_mm_movemask_epi8(above))) << k;
+        }
+
+        apOutput[i / 64] = word;
+    }
+
+    if (i < aWidth)
+    {
+        apOutput[i / 64] = thresholdWord(apInput, i, aWidth, aThresholdValue);
+    }
+}
+#endif
+
+
+//-------------------------------
+BinaryImage::BinaryImage():
+//-------------------------------
+        m_width(0),
+        m_height(0),
+        m_words_per_row(0)
+//-------------------------------
+{}
+
+
+//-------------------------------------------------------------------
+BinaryImage::BinaryImage(unsigned int aWidth, unsigned int aHeight):
+//-------------------------------------------------------------------
+        m_width(aWidth),
+        m_height(aHeight),
+        m_words_per_row((aWidth + 63) / 64),
+        m_word_set(m_words_per_row * aHeight, 0)
+//-------------------------------------------------------------------
+{}
+
+
+template <typename T>
+//--------------------------------------------------------------------------------
+BinaryImage::BinaryImage(const BasicImageView<T>& aView, double aThresholdValue):
+//--------------------------------------------------------------------------------
+        m_width(aView.getWidth()),
+        m_height(aView.getHeight()),
+        m_words_per_row((aView.getWidth() + 63) / 64),
+        m_word_set(m_words_per_row * aView.getHeight(), 0)
+//--------------------------------------------------------------------------------
+{
+    // If image is empty
+    if (aView.isEmpty())
+        throw "Image Empty";
+
+    // The rows are independent
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            thresholdRow(aView.getRow(j), m_width, aThresholdValue, getRow(j));
+        }
+    });
+}
+
+
+//------------------------------------------
+unsigned int BinaryImage::getWidth() const
+//------------------------------------------
+{
+    return (m_width);
+}
+
+
+//-------------------------------------------
+unsigned int BinaryImage::getHeight() const
+//-------------------------------------------
+{
+    return (m_height);
+}
+
+
+//------------------------------------------------
+unsigned int BinaryImage::getWordsPerRow() const
+//------------------------------------------------
+{
+    return (m_words_per_row);
+}
+
+
+//----------------------------------------------------
+std::uint64_t* BinaryImage::getRow(unsigned int j)
+//----------------------------------------------------
+{
+    return (&m_word_set[0] + j * m_words_per_row);
+}
+
+
+//----------------------------------------------------------------
+const std::uint64_t* BinaryImage::getRow(unsigned int j) const
+//----------------------------------------------------------------
+{
+    return (&m_word_set[0] + j * m_words_per_row);
+}
+
+
+//-------------------------------------------------------------------
+bool BinaryImage::getPixel(unsigned int i, unsigned int j) const
+//-------------------------------------------------------------------
+{
+    return ((getRow(j)[i / 64] >> (i % 64)) & 1);
+}
+
+
+//------------------------------------------------------------------------------
+void BinaryImage::setPixel(unsigned int i, unsigned int j, bool aValue)
+//------------------------------------------------------------------------------
+{
+    std::uint64_t bit(std::uint64_t(1) << (i % 64));
+
+    if (aValue)
+        getRow(j)[i / 64] |= bit;
+    else
+        getRow(j)[i / 64] &= ~bit;
+}
+
+
+//------------------------------------------
+unsigned int BinaryImage::getArea() const
+//------------------------------------------
+{
+    // The bits after the last pixel of the rows are 0
+    unsigned int area(0);
+    for (unsigned int k(0); k < m_word_set.size(); ++k)
+    {
+        area += countBits(m_word_set[k]);
+    }
+
+    return (area);
+}
+
+
+//---------------------------------------------------------------------
+BinaryImage& BinaryImage::operator&=(const BinaryImage& aMask)
+//---------------------------------------------------------------------
+{
+    checkSize(aMask);
+
+    for (unsigned int k(0); k < m_word_set.size(); ++k)
+    {
+        m_word_set[k] &= aMask.m_word_set[k];
+    }
+
+    return (*this);
+}
+
+
+//---------------------------------------------------------------------
+BinaryImage& BinaryImage::operator|=(const BinaryImage& aMask)
+//---------------------------------------------------------------------
+{
+    checkSize(aMask);
+
+    for (unsigned int k(0); k < m_word_set.size(); ++k)
+    {
+        m_word_set[k] |= aMask.m_word_set[k];
+    }
+
+    return (*this);
+}
+
+
+//---------------------------------------------------------------------
+BinaryImage& BinaryImage::operator^=(const BinaryImage& aMask)
+//---------------------------------------------------------------------
+{
+    checkSize(aMask);
+
+    for (unsigned int k(0); k < m_word_set.size(); ++k)
+    {
+        m_word_set[k] ^= aMask.m_word_set[k];
+    }
+
+    return (*this);
+}
+
+
+//--------------------------------------------------------------------------
+BinaryImage BinaryImage::operator&(const BinaryImage& aMask) const
+//--------------------------------------------------------------------------
+{
+    BinaryImage mask(*this);
+    return (mask &= aMask);
+}
+
+
+//--------------------------------------------------------------------------
+BinaryImage BinaryImage::operator|(const BinaryImage& aMask) const
+//--------------------------------------------------------------------------
+{
+    BinaryImage mask(*this);
+    return (mask |= aMask);
+}
+
+
+//--------------------------------------------------------------------------
+BinaryImage BinaryImage::operator^(const BinaryImage& aMask) const
+//--------------------------------------------------------------------------
+{
+    BinaryImage mask(*this);
+    return (mask ^= aMask);
+}
+
+
+//------------------------------------------------------------------------------------------
+BasicImage<double> BinaryImage::toImage(double aForegroundValue, double aBackgroundValue) const
+//------------------------------------------------------------------------------------------
+{
+    BasicImage<double> image(m_width, m_height);
+
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            const std::uint64_t* p_input(getRow(j));
+            double* p_output(image.getRow(j));
+
+            for (unsigned int i(0); i < m_width; ++i)
+            {
+                p_output[i] = (p_input[i / 64] >> (i % 64)) & 1 ?
+                        aForegroundValue : aBackgroundValue;
+            }
+        }
+    });
+
+    return (image);
+}
+
+
+//-------------------------------------------------------------
+void BinaryImage::checkSize(const BinaryImage& aMask) const
+//-------------------------------------------------------------
+{
+    if (m_width != aMask.m_width || m_height != aMask.m_height)
+        throw "Image Sizes are different";
+}
+
+
+//******************************************************************************
+//  Explicit instantiations
+//******************************************************************************
+template BinaryImage::BinaryImage(const BasicImageView<std::uint8_t>&, double);
+template BinaryImage::BinaryImage(const BasicImageView<std::uint16_t>&, double);
+template BinaryImage::BinaryImage(const BasicImageView<float>&, double);
+template BinaryImage::BinaryImage(const BasicImageView<double>&, double);
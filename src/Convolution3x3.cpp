@@ -0,0 +1,224 @@
+/**
+********************************************************************************
+*
+*   @file       Convolution3x3.cpp
+*
+*   @brief      Vectorised (SSE2/AVX2) 3x3 convolution of a row of pixels.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Define
+//******************************************************************************
+// AVX2 is compiled in a function specific target, then detected at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONVOLUTION_HAS_AVX2
+#endif
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h> // Header file for SSE2 intrinsics
+#define CONVOLUTION_HAS_SSE2
+#endif
+
+#ifdef CONVOLUTION_HAS_AVX2
+#include <immintrin.h> // Header file for AVX intrinsics
+#endif
+
+#include "Convolution3x3.h"
+
+
+/// Signature of the implementations
+typedef void (*Convolution3x3Function)(const double* const[3], const double[9], double*, unsigned int);
+
+
+//------------------------------------------------------------------------
+/// Convolve the pixels from aStart to aCount, one at a time.
+//------------------------------------------------------------------------
+static void convolveRow3x3Scalar(const double* const apRows[3],
+                                 const double aKernel[9],
+                                 double* apOutput,
+                                 unsigned int aStart,
+                                 unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    for (unsigned int i(aStart); i < aCount; ++i)
+    {
+        double pixel_sum(0.0);
+
+        for (unsigned int k_row(0); k_row < 3; ++k_row)
+            for (unsigned int k_col(0); k_col < 3; ++k_col)
+                pixel_sum += aKernel[k_row * 3 + k_col] * apRows[k_row][i + k_col];
+
+        apOutput[i] = pixel_sum;
+    }
+}
+
+
+#ifndef CONVOLUTION_HAS_SSE2
+//------------------------------------------------------------------------
+/// Plain C++ implementation.
+//------------------------------------------------------------------------
+static void convolveRow3x3Generic(const double* const apRows[3],
+                                  const double aKernel[9],
+                                  double* apOutput,
+                                  unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    convolveRow3x3Scalar(apRows, aKernel, apOutput, 0, aCount);
+}
+#endif
+
+
+#ifdef CONVOLUTION_HAS_SSE2
+//------------------------------------------------------------------------
+/// SSE2 implementation, 2 pixels at a time.
+//------------------------------------------------------------------------
+static void convolveRow3x3SSE2(const double* const apRows[3],
+                               const double aKernel[9],
+                               double* apOutput,
+                               unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    __m128d p_kernel[9];
+    for (unsigned int k(0); k < 9; ++k)
+        p_kernel[k] = _mm_set1_pd(aKernel[k]);
+
+    unsigned int i(0);
+    for (; i + 2 <= aCount; i += 2)
+    {
+        __m128d pixel_sum(_mm_setzero_pd());
+
+        // No FMA, the rounding is the same as in the scalar loop
+        for (unsigned int k_row(0); k_row < 3; ++k_row)
+            for (unsigned int k_col(0); k_col < 3; ++k_col)
+                pixel_sum = _mm_add_pd(pixel_sum,
+                        _mm_mul_pd(p_kernel[k_row * 3 + k_col],
+                                   _mm_loadu_pd(apRows[k_row] + i + k_col)));
+
+        _mm_storeu_pd(apOutput + i, pixel_sum);
+    }
+
+    // Remaining pixels
+    convolveRow3x3Scalar(apRows, aKernel, apOutput, i, aCount);
+}
+#endif
+
+
+#ifdef CONVOLUTION_HAS_AVX2
+//------------------------------------------------------------------------
+/// AVX2 implementation, 8 pixels at a time (two registers of 4 pixels).
+//------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static void convolveRow3x3AVX2(const double* const apRows[3],
+                               const double aKernel[9],
+                               double* apOutput,
+                               unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    __m256d p_kernel[9];
+    for (unsigned int k(0); k < 9; ++k)
+        p_kernel[k] = _mm256_set1_pd(aKernel[k]);
+
+    unsigned int i(0);
+    for (; i + 8 <= aCount; i += 8)
+    {
+        __m256d pixel_sum_0(_mm256_setzero_pd());
+        __m256d pixel_sum_1(_mm256_setzero_pd());
+
+        // No FMA, the rounding is the same as in the scalar loop
+        for (unsigned int k_row(0); k_row < 3; ++k_row)
+            for (unsigned int k_col(0); k_col < 3; ++k_col)
+            {
+                const double* p_data(apRows[k_row] + i + k_col);
+                pixel_sum_0 = _mm256_add_pd(pixel_sum_0,
+                        _mm256_mul_pd(p_kernel[k_row * 3 + k_col], _mm256_loadu_pd(p_data)));
+                pixel_sum_1 = _mm256_add_pd(pixel_sum_1,
+                        _mm256_mul_pd(p_kernel[k_row * 3 + k_col], _mm256_loadu_pd(p_data + 4)));
+            }
+
+        _mm256_storeu_pd(apOutput + i, pixel_sum_0);
+        _mm256_storeu_pd(apOutput + i + 4, pixel_sum_1);
+    }
+
+    // Remaining pixels
+    convolveRow3x3Scalar(apRows, aKernel, apOutput, i, aCount);
+}
+#endif
+
+
+//------------------------------------------------------------------------
+/// Select the best implementation supported by the CPU.
+//------------------------------------------------------------------------
+static Convolution3x3Function selectConvolution3x3(const char** apName)
+//------------------------------------------------------------------------
+{
+#ifdef CONVOLUTION_HAS_AVX2
+    if (__builtin_cpu_supports("avx2"))
+    {
+        *apName = "AVX2";
+        return (convolveRow3x3AVX2);
+    }
+#endif
+
+#ifdef CONVOLUTION_HAS_SSE2
+    *apName = "SSE2";
+    return (convolveRow3x3SSE2);
+#else
+    *apName = "none";
+    return (convolveRow3x3Generic);
+#endif
+}
+
+
+//------------------------------------------------------------------------
+/// Accessor on the selected implementation, which is selected only once.
+//------------------------------------------------------------------------
+static Convolution3x3Function getConvolution3x3(const char** apName = 0)
+//------------------------------------------------------------------------
+{
+    static const char* p_name(0);
+    static const Convolution3x3Function p_function(selectConvolution3x3(&p_name));
+
+    if (apName)
+    {
+        *apName = p_name;
+    }
+
+    return (p_function);
+}
+
+
+//------------------------------------------------------
+void convolveRow3x3(const double* const apRows[3],
+                    const double aKernel[9],
+                    double* apOutput,
+                    unsigned int aCount)
+//------------------------------------------------------
+{
+    getConvolution3x3()(apRows, aKernel, apOutput, aCount);
+}
+
+
+//------------------------------------------------------
+const char* getConvolution3x3InstructionSet()
+//------------------------------------------------------
+{
+    const char* p_name(0);
+    getConvolution3x3(&p_name);
+
+    return (p_name);
+}
@@ -0,0 +1,311 @@
+/**
+********************************************************************************
+*
+*   @file       FFT.cpp
+*
+*   @brief      Mixed-radix fast Fourier transform, with plans cached by
+*               length.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <cmath> // Header file for cos/sin/sqrt
+#include <map>
+#include <memory> // Header file for unique_ptr
+#include <mutex>
+
+#include "FFT.h"
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Product of two complex numbers (std::complex checks for infinities,
+/// which is much slower).
+/**
+* @param a: the first number
+* @param b: the second number
+* @return the product
+*/
+//------------------------------------------------------------------------
+static inline Complex multiply(const Complex& a, const Complex& b)
+//------------------------------------------------------------------------
+{
+    return (Complex(a.real() * b.real() - a.imag() * b.imag(),
+                    a.real() * b.imag() + a.imag() * b.real()));
+}
+
+
+//---------------------------------------------------------
+FFTPlan::FFTPlan(unsigned int aLength):
+//---------------------------------------------------------
+        m_length(aLength),
+        m_forward_twiddle_set(aLength),
+        m_inverse_twiddle_set(aLength)
+//---------------------------------------------------------
+{
+    // Invalid length
+    if (!aLength)
+    {
+        throw "Invalid FFT length";
+    }
+
+    const double pi(std::acos(-1.0));
+    for (unsigned int k(0); k < aLength; ++k)
+    {
+        double angle(-2.0 * pi * k / aLength);
+        m_forward_twiddle_set[k] = Complex(std::cos(angle), std::sin(angle));
+        m_inverse_twiddle_set[k] = std::conj(m_forward_twiddle_set[k]);
+    }
+
+    // Factors of 4 first, then 2, then the odd factors
+    unsigned int remainder(aLength);
+    unsigned int factor(4);
+    unsigned int sqrt_length(std::sqrt(double(aLength)));
+    while (remainder > 1)
+    {
+        while (remainder % factor)
+        {
+            if (factor == 4)
+            {
+                factor = 2;
+            }
+            else if (factor == 2)
+            {
+                factor = 3;
+            }
+            else
+            {
+                factor += 2;
+            }
+
+            // The remainder is prime
+            if (factor > sqrt_length)
+            {
+                factor = remainder;
+            }
+        }
+
+        remainder /= factor;
+        m_factor_set.push_back(factor);
+        m_factor_set.push_back(remainder);
+    }
+
+    // A signal of a single sample
+    if (m_factor_set.empty())
+    {
+        m_factor_set.push_back(1);
+        m_factor_set.push_back(1);
+    }
+}
+
+
+//---------------------------------------------
+unsigned int FFTPlan::getLength() const
+//---------------------------------------------
+{
+    return (m_length);
+}
+
+
+//------------------------------------------------------------------------------------------
+void FFTPlan::transform(const Complex* apInput, Complex* apOutput, bool anInverse) const
+//------------------------------------------------------------------------------------------
+{
+    transformStage(apOutput, apInput, 1, 0,
+                   anInverse ? &m_inverse_twiddle_set[0] : &m_forward_twiddle_set[0],
+                   anInverse);
+}
+
+
+//-------------------------------------------------------------
+const FFTPlan& FFTPlan::getPlan(unsigned int aLength)
+//-------------------------------------------------------------
+{
+    static std::mutex mutex;
+    static std::map<unsigned int, std::unique_ptr<FFTPlan> > plan_set;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<FFTPlan>& p_plan(plan_set[aLength]);
+    if (!p_plan)
+    {
+        p_plan.reset(new FFTPlan(aLength));
+    }
+
+    return (*p_plan);
+}
+
+
+//-------------------------------------------------------------------
+void FFTPlan::transformStage(Complex* apOutput,
+                             const Complex* apInput,
+                             unsigned int aStride,
+                             unsigned int aFactorIndex,
+                             const Complex* apTwiddles,
+                             bool anInverse) const
+//-------------------------------------------------------------------
+{
+    // Radix of the stage and length of the sub-transforms
+    unsigned int p(m_factor_set[aFactorIndex]);
+    unsigned int m(m_factor_set[aFactorIndex + 1]);
+
+    // Decimation in time: the p sub-transforms of the interleaved samples
+    if (m == 1)
+    {
+        for (unsigned int q(0); q < p; ++q)
+        {
+            apOutput[q] = apInput[q * aStride];
+        }
+    }
+    else
+    {
+        for (unsigned int q(0); q < p; ++q)
+        {
+            transformStage(apOutput + q * m, apInput + q * aStride, aStride * p,
+                           aFactorIndex + 2, apTwiddles, anInverse);
+        }
+    }
+
+    // Combine the sub-transforms
+    switch (p)
+    {
+    case 1:
+        break;
+
+    case 2:
+        for (unsigned int k(0); k < m; ++k)
+        {
+            Complex t(multiply(apOutput[k + m], apTwiddles[k * aStride]));
+            apOutput[k + m] = apOutput[k] - t;
+            apOutput[k] += t;
+        }
+        break;
+
+    case 3:
+        {
+            // Imaginary part of exp(-+2 pi i / 3)
+            double sin_third(apTwiddles[aStride * m].imag());
+
+            for (unsigned int k(0); k < m; ++k)
+            {
+                Complex s1(multiply(apOutput[k + m], apTwiddles[k * aStride]));
+                Complex s2(multiply(apOutput[k + 2 * m], apTwiddles[2 * k * aStride]));
+                Complex s3(s1 + s2);
+                Complex s0((s1 - s2) * sin_third);
+
+                Complex base(apOutput[k] - s3 * 0.5);
+                apOutput[k] += s3;
+                apOutput[k + m] = Complex(base.real() - s0.imag(), base.imag() + s0.real());
+                apOutput[k + 2 * m] = Complex(base.real() + s0.imag(), base.imag() - s0.real());
+            }
+        }
+        break;
+
+    case 4:
+        for (unsigned int k(0); k < m; ++k)
+        {
+            Complex s0(multiply(apOutput[k + m], apTwiddles[k * aStride]));
+            Complex s1(multiply(apOutput[k + 2 * m], apTwiddles[2 * k * aStride]));
+            Complex s2(multiply(apOutput[k + 3 * m], apTwiddles[3 * k * aStride]));
+
+            Complex s5(apOutput[k] - s1);
+            Complex s4(s0 - s2);
+            Complex s3(s0 + s2);
+            Complex first(apOutput[k] + s1);
+
+            apOutput[k] = first + s3;
+            apOutput[k + 2 * m] = first - s3;
+
+            // Multiplication of s4 by -i (forward) or i (inverse)
+            if (anInverse)
+            {
+                apOutput[k + m] = Complex(s5.real() - s4.imag(), s5.imag() + s4.real());
+                apOutput[k + 3 * m] = Complex(s5.real() + s4.imag(), s5.imag() - s4.real());
+            }
+            else
+            {
+                apOutput[k + m] = Complex(s5.real() + s4.imag(), s5.imag() - s4.real());
+                apOutput[k + 3 * m] = Complex(s5.real() - s4.imag(), s5.imag() + s4.real());
+            }
+        }
+        break;
+
+    default:
+        {
+            // Direct DFT of size p for each output
+            std::vector<Complex> scratch(p);
+            for (unsigned int u(0); u < m; ++u)
+            {
+                for (unsigned int q(0); q < p; ++q)
+                {
+                    scratch[q] = apOutput[u + q * m];
+                }
+
+                for (unsigned int q1(0); q1 < p; ++q1)
+                {
+                    unsigned int k(u + q1 * m);
+                    unsigned int twiddle_index(0);
+                    Complex sum(scratch[0]);
+
+                    for (unsigned int q(1); q < p; ++q)
+                    {
+                        twiddle_index += aStride * k;
+                        twiddle_index %= m_length;
+                        sum += multiply(scratch[q], apTwiddles[twiddle_index]);
+                    }
+
+                    apOutput[k] = sum;
+                }
+            }
+        }
+        break;
+    }
+}
+
+
+//------------------------------------------------------
+unsigned int getFFTSize(unsigned int aMinimumLength)
+//------------------------------------------------------
+{
+    unsigned int length(aMinimumLength ? aMinimumLength : 1);
+
+    while (true)
+    {
+        // Remove the factors 2, 3 and 5
+        unsigned int remainder(length);
+        while (remainder % 2 == 0)
+        {
+            remainder /= 2;
+        }
+        while (remainder % 3 == 0)
+        {
+            remainder /= 3;
+        }
+        while (remainder % 5 == 0)
+        {
+            remainder /= 5;
+        }
+
+        if (remainder == 1)
+        {
+            return (length);
+        }
+
+        ++length;
+    }
+}
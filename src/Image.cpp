@@ -22,8 +22,7 @@
 //  Define
 //******************************************************************************
 #define LINE_SIZE 2048
-#define KERNEL_WIDTH 3
-#define KERNEL_HEIGHT 3
+
 //******************************************************************************
 //  Include
 //******************************************************************************
@@ -31,85 +30,624 @@
 #include <iostream> //cout
 #include <fstream> // Header file for filestream
 #include <algorithm> // Header file for min/max/fill
+#include <cctype> // Header file for isspace
+#include <cerrno> // Header file for errno
+#include <cstdlib> // Header file for strtod
+#include <cstring> // Header file for memchr
 #include <cmath> // Header file for abs
+#include <limits>
 #include <vector>
 #include <numeric> //accumate
+#include <utility> // Header file for move
+#include <charconv> // Header file for from_chars
+
+// Some standard libraries do not provide from_chars for floating-point numbers
+#ifdef __cpp_lib_to_chars
+#define IMAGE_HAS_FROM_CHARS
+#endif
 
 #include "Image.h"
+#include "AlignedMemory.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Apply a point operation to every pixel of an image.
+/**
+* @param aSource: the pixels
+* @param aDestination: the result, of the same size (it can be aSource)
+* @param aFunction: the operation, computed in double precision
+*/
+//------------------------------------------------------------------------
+template <typename T, typename F>
+static void mapPixelsDirectly(const BasicImage<T>& aSource,
+                              BasicImage<T>& aDestination,
+                              F aFunction)
+//------------------------------------------------------------------------
+{
+    parallelForRows(aSource.getHeight(), [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            const T* p_input(aSource.getRow(j));
+            T* p_output(aDestination.getRow(j));
+
+            for (unsigned int i(0); i < aSource.getWidth(); ++i)
+            {
+                p_output[i] = PixelTraits<T>::fromDouble(aFunction(p_input[i]));
+            }
+        }
+    });
+}
+
+
+//------------------------------------------------------------------------
+/// Map every pixel of an image through a table.
+/**
+* @param aTable: the table
+* @param aSource: the pixels
+* @param aDestination: the result, of the same size (it can be aSource)
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static void mapPixelsThroughTable(const LookUpTable<T>& aTable,
+                                  const BasicImageView<T>& aSource,
+                                  BasicImage<T>& aDestination)
+//------------------------------------------------------------------------
+{
+    parallelForRows(aSource.getHeight(), [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            aTable.apply(aSource.getRow(j), aDestination.getRow(j), aSource.getWidth());
+        }
+    });
+}
+
+
+//------------------------------------------------------------------------
+/// Apply a point operation to every pixel of an 8-bit or 16-bit image.
+/// The operation is computed once per pixel value when the image has more
+/// pixels than the table has entries.
+/**
+* @param aSource: the pixels
+* @param aDestination: the result, of the same size (it can be aSource)
+* @param aFunction: the operation, computed in double precision
+*/
+//------------------------------------------------------------------------
+template <typename T, typename F>
+static void mapIntegerPixels(const BasicImage<T>& aSource,
+                             BasicImage<T>& aDestination,
+                             F aFunction)
+//------------------------------------------------------------------------
+{
+    double numberOfValues(double(std::numeric_limits<T>::max()) + 1.0);
+    if (double(aSource.getWidth()) * aSource.getHeight() < numberOfValues)
+    {
+        mapPixelsDirectly(aSource, aDestination, aFunction);
+    }
+    else
+    {
+        mapPixelsThroughTable(LookUpTable<T>().append(aFunction), aSource.getView(), aDestination);
+    }
+}
+
+
+//------------------------------------------------------------------------
+/// Apply a point operation to every pixel of an image, the pixel types
+/// without a table compute the operation for every pixel.
+/**
+* @param aSource: the pixels
+* @param aDestination: the result, of the same size (it can be aSource)
+* @param aFunction: the operation, computed in double precision
+*/
+//------------------------------------------------------------------------
+template <typename T, typename F>
+static void mapPixels(const BasicImage<T>& aSource, BasicImage<T>& aDestination, F aFunction)
+//------------------------------------------------------------------------
+{
+    mapPixelsDirectly(aSource, aDestination, aFunction);
+}
+
+
+template <typename F>
+static void mapPixels(const Image8& aSource, Image8& aDestination, F aFunction)
+{
+    mapIntegerPixels(aSource, aDestination, aFunction);
+}
+
+
+template <typename F>
+static void mapPixels(const Image16& aSource, Image16& aDestination, F aFunction)
+{
+    mapIntegerPixels(aSource, aDestination, aFunction);
+}
+
+
+//------------------------------------------------------------------------
+/// Map every pixel of an image through a table, only the 8-bit and 16-bit
+/// pixels have tables.
+/**
+* @param aTable: the table
+* @param anImage: the image
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static void applyTable(const LookUpTable<T>&, BasicImage<T>&)
+//------------------------------------------------------------------------
+{
+    throw "Look-up tables need 8-bit or 16-bit pixels";
+}
+
+
+static void applyTable(const LookUpTable<std::uint8_t>& aTable, Image8& anImage)
+{
+    mapPixelsThroughTable(aTable, anImage.getView(), anImage);
+}
+
+
+static void applyTable(const LookUpTable<std::uint16_t>& aTable, Image16& anImage)
+{
+    mapPixelsThroughTable(aTable, anImage.getView(), anImage);
+}
+
+
+//------------------------------------------------------------------------
+/// Store the negative of an 8-bit or 16-bit image through a table, when
+/// the image has more pixels than the table has entries.
+/**
+* @param anExpression: the negative
+* @param anImage: the result, of the same size
+* @return true if the pixels have been stored, false otherwise
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static bool negateIntegerPixels(const ImageNegationExpression<BasicImageView<T> >& anExpression,
+                                BasicImage<T>& anImage)
+//------------------------------------------------------------------------
+{
+    double numberOfValues(double(std::numeric_limits<T>::max()) + 1.0);
+    if (double(anImage.getWidth()) * anImage.getHeight() < numberOfValues)
+    {
+        return (false);
+    }
+
+    LookUpTable<T> table;
+    table.negate(anExpression.getMinValue(), anExpression.getMaxValue());
+    mapPixelsThroughTable(table, anExpression.getOperand(), anImage);
+
+    return (true);
+}
+
+
+//------------------------------------------------------------------------
+/// Store the negative of an image through a table, only the 8-bit and
+/// 16-bit pixels have tables.
+/**
+* @return false
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static bool negateThroughTable(const ImageNegationExpression<BasicImageView<T> >&, BasicImage<T>&)
+//------------------------------------------------------------------------
+{
+    return (false);
+}
+
+
+static bool negateThroughTable(const ImageNegationExpression<BasicImageView<std::uint8_t> >& anExpression,
+                               Image8& anImage)
+{
+    return (negateIntegerPixels(anExpression, anImage));
+}
+
+
+static bool negateThroughTable(const ImageNegationExpression<BasicImageView<std::uint16_t> >& anExpression,
+                               Image16& anImage)
+{
+    return (negateIntegerPixels(anExpression, anImage));
+}
+
+
+//------------------------------------------------------------------------
+/// Read the next value of the header of a PGM file, the white spaces and
+/// the comments before it are skipped.
+/**
+* @param anInput: the file
+* @param aFileName: the name of the file
+* @return the value
+*/
+//------------------------------------------------------------------------
+static int readPGMHeaderValue(std::istream& anInput, const char* aFileName)
+//------------------------------------------------------------------------
+{
+    int value(-1);
+    while (anInput.good())
+    {
+        int c(anInput.peek());
+
+        // Skip the comment, up to the end of the line
+        if (c == '#')
+        {
+            anInput.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        }
+        // Skip the white spaces
+        else if (std::isspace(c))
+        {
+            anInput.get();
+        }
+        // Read the value
+        else
+        {
+            anInput >> value;
+            break;
+        }
+    }
+
+    // The value is missing
+    if (value < 0)
+    {
+        // Build the error message
+        std::stringstream error_message;
+        error_message << "Invalid file (\"" << aFileName << "\")";
+
+        // Throw an error
+        throw (error_message.str());
+    }
+
+    return (value);
+}
+
+
+//------------------------------------------------------------------------
+/// Append a non-negative integer to a text.
+/**
+* @param aText: the text
+* @param aValue: the value
+*/
+//------------------------------------------------------------------------
+static void appendInteger(std::string& aText, unsigned int aValue)
+//------------------------------------------------------------------------
+{
+    // The digits, from the last one
+    char p_digits[10];
+    unsigned int number_of_digits(0);
+    do
+    {
+        p_digits[number_of_digits++] = char('0' + aValue % 10);
+        aValue /= 10;
+    }
+    while (aValue);
+
+    while (number_of_digits)
+    {
+        aText += p_digits[--number_of_digits];
+    }
+}
+
+
+//------------------------------------------------------------------------
+/// Check that a number parsed by strtod or from_chars is read by
+/// operator>> too, which rejects the hexadecimal numbers, inf, nan, and
+/// an exponent without digits (e.g. "1e", where the others stop before
+/// the exponent).
+/**
+* @param apBegin: the first character of the number
+* @param apNumberEnd: the character after the number
+* @param apEnd: the end of the line
+* @return true if the number is valid
+*/
+//------------------------------------------------------------------------
+static bool isStreamNumber(const char* apBegin, const char* apNumberEnd, const char* apEnd)
+//------------------------------------------------------------------------
+{
+    for (const char* p(apBegin); p < apNumberEnd; ++p)
+    {
+        if (!std::strchr("0123456789+-.eE", *p))
+        {
+            return (false);
+        }
+    }
+
+    return (apNumberEnd == apEnd || (*apNumberEnd != 'e' && *apNumberEnd != 'E'));
+}
+
+
+//------------------------------------------------------------------------
+/// Parse a decimal number whose digits form an integer below 2^53 and
+/// whose power of ten is at most 22, which are exact doubles.
+/**
+* @param apBegin: the first character of the number
+* @param apEnd: the end of the line
+* @param aValue: the value
+* @return the text after the number, or 0 if the number is not of this
+*         form or is not followed by a white space or the end of the line
+*/
+//------------------------------------------------------------------------
+static const char* parseShortDecimal(const char* apBegin, const char* apEnd, double& aValue)
+//------------------------------------------------------------------------
+{
+    static const double p_power_of_ten[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    const std::uint64_t max_mantissa(std::uint64_t(1) << 53);
+
+    const char* p(apBegin);
+    bool negative(p < apEnd && *p == '-');
+    if (p < apEnd && (*p == '-' || *p == '+'))
+    {
+        ++p;
+    }
+
+    // The digits, before and after the decimal point
+    std::uint64_t mantissa(0);
+    int exponent(0);
+    unsigned int number_of_digits(0);
+    for (; p < apEnd && *p >= '0' && *p <= '9'; ++p, ++number_of_digits)
+    {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa >= max_mantissa)
+        {
+            return (0);
+        }
+    }
+
+    if (p < apEnd && *p == '.')
+    {
+        for (++p; p < apEnd && *p >= '0' && *p <= '9'; ++p, ++number_of_digits)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            --exponent;
+            if (mantissa >= max_mantissa)
+            {
+                return (0);
+            }
+        }
+    }
+
+    // No digit
+    if (!number_of_digits)
+    {
+        return (0);
+    }
+
+    // The exponent
+    if (p < apEnd && (*p == 'e' || *p == 'E'))
+    {
+        const char* p_exponent(p + 1);
+        bool negative_exponent(p_exponent < apEnd && *p_exponent == '-');
+        if (p_exponent < apEnd && (*p_exponent == '-' || *p_exponent == '+'))
+        {
+            ++p_exponent;
+        }
+
+        // Too many digits or no digit, left to the general parser
+        int explicit_exponent(0);
+        const char* p_first_digit(p_exponent);
+        for (; p_exponent < apEnd && *p_exponent >= '0' && *p_exponent <= '9'; ++p_exponent)
+        {
+            if (p_exponent - p_first_digit >= 4)
+            {
+                return (0);
+            }
+            explicit_exponent = explicit_exponent * 10 + (*p_exponent - '0');
+        }
+
+        if (p_exponent == p_first_digit)
+        {
+            return (0);
+        }
+
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        p = p_exponent;
+    }
+
+    // Anything else than a separator after the number is left to the general parser
+    if (p < apEnd && *p && !std::isspace(static_cast<unsigned char>(*p)))
+    {
+        return (0);
+    }
+
+    // The power of ten is not exact
+    if (exponent < -22 || exponent > 22)
+    {
+        return (0);
+    }
 
+    double value(static_cast<double>(mantissa));
+    value = exponent < 0 ? value / p_power_of_ten[-exponent] : value * p_power_of_ten[exponent];
+    aValue = negative ? -value : value;
 
+    return (p);
+}
+
+
+//------------------------------------------------------------------------
+/// Parse the next value of a line of an ASCII file. The values are
+/// separated by white spaces, the line is followed by a null character or
+/// a new line.
+/**
+* @param apBegin: the text after the previous value
+* @param apEnd: the end of the line
+* @param aValue: the value
+* @return the text after the value, or 0 if there is no valid value
+*/
+//------------------------------------------------------------------------
+static const char* parseASCIIValue(const char* apBegin, const char* apEnd, double& aValue)
+//------------------------------------------------------------------------
+{
+    // Skip the white spaces
+    while (apBegin < apEnd && std::isspace(static_cast<unsigned char>(*apBegin)))
+    {
+        ++apBegin;
+    }
+
+    // The end of the line
+    if (apBegin == apEnd)
+    {
+        return (0);
+    }
+
+    // Most values have few digits: when the digits form an integer below
+    // 2^53 and the power of ten is exact, a single multiplication or
+    // division gives the correctly rounded value
+    const char* p_number_end(parseShortDecimal(apBegin, apEnd, aValue));
+    if (p_number_end)
+    {
+        return (p_number_end);
+    }
+
+#ifdef IMAGE_HAS_FROM_CHARS
+    // from_chars does not accept the sign +
+    const char* p_number(*apBegin == '+' ? apBegin + 1 : apBegin);
+    std::from_chars_result result(std::from_chars(p_number, apEnd, aValue));
+
+    if (result.ec == std::errc())
+    {
+        return (isStreamNumber(apBegin, result.ptr, apEnd) ? result.ptr : 0);
+    }
+    // Out of range values are handled by strtod below
+    else if (result.ec != std::errc::result_out_of_range)
+    {
+        return (0);
+    }
+#endif
+
+    // The text of the line is followed by a character that ends the number
+    char* p_strtod_end(0);
+    errno = 0;
+    aValue = std::strtod(apBegin, &p_strtod_end);
+
+    // No value, or a value that overflows (as operator>>)
+    if (p_strtod_end == apBegin || (errno == ERANGE && std::abs(aValue) == HUGE_VAL))
+    {
+        return (0);
+    }
+
+    return (isStreamNumber(apBegin, p_strtod_end, apEnd) ? p_strtod_end : 0);
+}
+
+
+template <typename T>
 //------------------
-Image::Image():
+BasicImage<T>::BasicImage():
 //------------------
         m_width(0),
         m_height(0),
-        m_p_image(0)
+        m_stride(0),
+        m_p_image(0),
+        m_statistics(),
+        m_statistics_valid(false)
 //------------------
 {}
 
 
+template <typename T>
 //----------------------------------------------
-Image::Image(const Image& anImage):
+BasicImage<T>::BasicImage(const BasicImage& anImage):
 //----------------------------------------------
         m_width(anImage.m_width),
         m_height(anImage.m_height),
-        m_p_image(new double[m_width * m_height])
+        m_stride(anImage.m_stride),
+        m_p_image(allocatePixels(m_height * m_stride)),
+        m_statistics(),
+        m_statistics_valid(false)
 //----------------------------------------------
 {
-    // Out of memeory
-    if (m_width && m_height && !m_p_image)
-    {
-        throw "Out of memory";
-    }
-    
-    // Copy the data
-    std::copy(anImage.m_p_image, anImage.m_p_image + m_width * m_height, m_p_image);
+    // Copy the data (including the padding at the end of the rows)
+    std::copy(anImage.m_p_image, anImage.m_p_image + m_height * m_stride, m_p_image);
+    copyStatistics(anImage);
 }
 
 
+template <typename T>
+//----------------------------------------------
+BasicImage<T>::BasicImage(BasicImage&& anImage) noexcept:
+//----------------------------------------------
+        m_width(anImage.m_width),
+        m_height(anImage.m_height),
+        m_stride(anImage.m_stride),
+        m_p_image(anImage.m_p_image),
+        m_statistics(anImage.m_statistics),
+        m_statistics_valid(anImage.m_statistics_valid.load())
 //----------------------------------------------
-Image::Image(const double* apData,
+{
+    // The pixel data now belongs to the current instance
+    anImage.m_width   = 0;
+    anImage.m_height  = 0;
+    anImage.m_stride  = 0;
+    anImage.m_p_image = 0;
+    anImage.m_statistics_valid = false;
+}
+
+
+template <typename T>
+//----------------------------------------------
+BasicImage<T>::BasicImage(const T* apData,
              unsigned int aWidth,
              unsigned int aHeight):
 //----------------------------------------------
         m_width(aWidth),
         m_height(aHeight),
-        m_p_image(new double[m_width * m_height])
+        m_stride(getDefaultStride(aWidth)),
+        m_p_image(allocatePixels(m_height * m_stride)),
+        m_statistics(),
+        m_statistics_valid(false)
 //----------------------------------------------
 {
-    // Out of memeory
-    if (m_width && m_height && !m_p_image)
+    // Copy the data, one row at a time
+    for (unsigned int j(0); j < m_height; ++j)
     {
-        throw "Out of memory";
+        std::copy(apData + j * m_width, apData + (j + 1) * m_width, getRow(j));
     }
+}
+
 
-    // Copy the data
-    std::copy(apData, apData + m_width * m_height, m_p_image);
+template <typename T>
+//----------------------------------------------------------
+BasicImage<T>::BasicImage(const BasicImageView<T>& aView):
+//----------------------------------------------------------
+        m_width(aView.getWidth()),
+        m_height(aView.getHeight()),
+        m_stride(getDefaultStride(m_width)),
+        m_p_image(allocatePixels(m_height * m_stride)),
+        m_statistics(),
+        m_statistics_valid(false)
+//----------------------------------------------------------
+{
+    // Copy the data, one row at a time
+    for (unsigned int j(0); j < m_height; ++j)
+    {
+        std::copy(aView.getRow(j), aView.getRow(j) + m_width, getRow(j));
+    }
 }
 
 
+template <typename T>
 //----------------------------------------------
-Image::Image(unsigned int aWidth,
-             unsigned int aHeight):
+BasicImage<T>::BasicImage(unsigned int aWidth,
+             unsigned int aHeight,
+             unsigned int aStride):
 //----------------------------------------------
         m_width(aWidth),
         m_height(aHeight),
-        m_p_image(new double[m_width * m_height])
+        m_stride(aStride ? getAlignedStride(std::max(aStride, aWidth)) : getDefaultStride(aWidth)),
+        m_p_image(allocatePixels(m_height * m_stride)),
+        m_statistics(),
+        m_statistics_valid(false)
 //----------------------------------------------
 {
-    // Out of memeory
-    if (m_width && m_height && !m_p_image)
-    {
-        throw "Out of memory";
-    }
-
     // Initialise the data
-    std::fill_n(m_p_image, m_width * m_height, 0);
+    std::fill_n(m_p_image, m_height * m_stride, 0);
 }
 
 
+template <typename T>
 //-------------
-Image::~Image()
+BasicImage<T>::~BasicImage()
 //-------------
 {
     // Release memory
@@ -117,15 +655,16 @@ Image::~Image()
 }
 
 
+template <typename T>
 //-------------------
-void Image::destroy()
+void BasicImage<T>::destroy()
 //-------------------
 {
     // Memory has been dynamically allocated
     if (m_p_image)
     {
         // Release the memory
-        delete [] m_p_image;
+        releaseAligned(m_p_image);
     
         // Make sure the pointer is reset to NULL
         m_p_image = 0;
@@ -134,46 +673,87 @@ void Image::destroy()
     // There is no pixel in the image
     m_width  = 0;
     m_height = 0;
+    m_stride = 0;
+    m_statistics_valid = false;
 }
 
 
-//---------------------------------------------
-Image Image::getROI(unsigned int i,
-                    unsigned int j,
-                    unsigned int aWidth,
-                    unsigned int aHeight) const
-//---------------------------------------------
+template <typename T>
+//-----------------------------------------------------------------
+unsigned int BasicImage<T>::getAlignedStride(unsigned int aWidth)
+//-----------------------------------------------------------------
 {
-    // Create a black image
-    Image roi(aWidth, aHeight);
+    // Number of pixels in a block of MEMORY_ALIGNMENT bytes
+    const unsigned int pixels_per_block(MEMORY_ALIGNMENT / sizeof(T));
 
-    // Process every row of the ROI
-    for (unsigned y(0); y < aHeight; ++y)
-    {
-        // Process every column of the ROI
-        for (unsigned x(0); x < aWidth; ++x)
-        {
-            unsigned int index_i(x + i);
-            unsigned int index_j(y +j);
+    // Round up to a whole number of blocks
+    return ((aWidth + pixels_per_block - 1) / pixels_per_block * pixels_per_block);
+}
 
-            // The pixel index is valid
-            if ((index_i < m_width) && (index_j < m_height))
-            {
-                // Get the pixel intensity from the current instance
-                double intensity(getPixel(index_i, index_j));
 
-                // Set the pixel of the ROI
-                roi.setPixel(x, y, intensity);
-            }
-        }
+template <typename T>
+//-----------------------------------------------------------------
+unsigned int BasicImage<T>::getDefaultStride(unsigned int aWidth)
+//-----------------------------------------------------------------
+{
+    unsigned int stride(getAlignedStride(aWidth));
+
+    // Rows that are a multiple of 1KB apart map onto the same cache sets
+    // (e.g. 512-pixel wide double images), add one cache line of padding
+    if (stride && (stride * sizeof(T)) % 1024 == 0)
+    {
+        stride += MEMORY_ALIGNMENT / sizeof(T);
     }
-    
-    return (roi);
+
+    return (stride);
 }
 
 
+template <typename T>
+//------------------------------------------------------------
+T* BasicImage<T>::allocatePixels(unsigned int aNumberOfPixels)
+//------------------------------------------------------------
+{
+    return (static_cast<T*>(allocateAligned(std::size_t(aNumberOfPixels) * sizeof(T))));
+}
+
+
+template <typename T>
+//------------------------------------------------------------
+void BasicImage<T>::copyStatistics(const BasicImage& anImage)
+//------------------------------------------------------------
+{
+    std::lock_guard<std::mutex> lock(anImage.m_statistics_mutex);
+    m_statistics = anImage.m_statistics;
+    m_statistics_valid = anImage.m_statistics_valid.load();
+}
+
+
+template <typename T>
+//---------------------------------------------------------
+BasicImageView<T> BasicImage<T>::getROI(unsigned int i,
+                                        unsigned int j,
+                                        unsigned int aWidth,
+                                        unsigned int aHeight) const
+//---------------------------------------------------------
+{
+    // Restrict the view of the whole image
+    return (getView().getROI(i, j, aWidth, aHeight));
+}
+
+
+template <typename T>
+//-----------------------------------------------
+BasicImageView<T> BasicImage<T>::getView() const
+//-----------------------------------------------
+{
+    return (BasicImageView<T>(m_p_image, m_width, m_height, m_stride));
+}
+
+
+template <typename T>
 //----------------------------------------------------------------
-void Image::setPixel(unsigned int i, unsigned int j, double aValue)
+void BasicImage<T>::setPixel(unsigned int i, unsigned int j, T aValue)
 //----------------------------------------------------------------
 {
     
@@ -185,12 +765,14 @@ void Image::setPixel(unsigned int i, unsigned int j, double aValue)
     }
     
     // Change the pixel value
-    m_p_image[j * m_width + i] = aValue;
+    m_p_image[j * m_stride + i] = aValue;
+    m_statistics_valid = false;
 }
 
 
+template <typename T>
 //---------------------------------------------------------
-double Image::getPixel(unsigned int i, unsigned int j) const
+T BasicImage<T>::getPixel(unsigned int i, unsigned int j) const
 //---------------------------------------------------------
 {
     // The pixel index is valid
@@ -200,239 +782,179 @@ double Image::getPixel(unsigned int i, unsigned int j) const
     }
     
     // Return the pixel value
-    return (m_p_image[j * m_width + i]);
+    return (m_p_image[j * m_stride + i]);
 }
 
 
+template <typename T>
 //-------------------------------------------
-Image& Image::operator=(const Image& anImage)
+T* BasicImage<T>::getRow(unsigned int j)
 //-------------------------------------------
 {
-    // The images different
-    if (this != &anImage)
-    {
-        // Release memory
-        destroy();
+    // The pixels of the row may be changed
+    m_statistics_valid = false;
 
-        // Copy the image properites
-        m_width   = anImage.m_width;
-        m_height  = anImage.m_height;
-        m_p_image = new double[m_width * m_height];
+    return (m_p_image + j * m_stride);
+}
 
-        // Out of memeory
-        if (m_width && m_height && !m_p_image)
-        {
-            throw "Out of memory";
-        }
-        
-        // Copy the data
-        std::copy(anImage.m_p_image, anImage.m_p_image + m_width * m_height, m_p_image);
-    }
 
-    // Return the instance
-    return (*this);
+template <typename T>
+//-------------------------------------------------
+const T* BasicImage<T>::getRow(unsigned int j) const
+//-------------------------------------------------
+{
+    return (m_p_image + j * m_stride);
 }
 
 
-//------------------------------------------
-Image Image::operator+(const Image& anImage)
-//------------------------------------------
+template <typename T>
+//-------------------------------------------
+T* BasicImage<T>::getRowData(unsigned int j)
+//-------------------------------------------
 {
-    // Deal with images of different sizes
-    unsigned int min_width(std::min(m_width, anImage.m_width));
-    unsigned int min_height(std::min(m_height, anImage.m_height));
-    
-    // Copy the instance into a temporary variable
-    Image temp(getROI(0, 0, min_width, min_height));
-    
-    // Copy the data
-    for (unsigned int j(0); j < min_height; ++j)
-    {
-        for (unsigned int i(0); i < min_width; ++i)
-        {
-            temp.m_p_image[j * temp.m_width + i] += anImage.m_p_image[j * anImage.m_width + i];
-        }
-    }
-    
-    // Return the result
-    return (temp);
+    return (m_p_image + j * m_stride);
 }
 
 
-//------------------------------------------
-Image Image::operator-(const Image& anImage)
-//------------------------------------------
+template <typename T>
+//-------------------------------------------
+BasicImage<T>& BasicImage<T>::operator=(const BasicImage& anImage)
+//-------------------------------------------
 {
-    // Deal with images of different sizes
-    unsigned int min_width(std::min(m_width, anImage.m_width));
-    unsigned int min_height(std::min(m_height, anImage.m_height));
-    
-    // Copy the instance into a temporary variable
-    Image temp(getROI(0, 0, min_width, min_height));
-    
-    // Copy the data
-    for (unsigned int j(0); j < min_height; ++j)
+    // The images different
+    if (this != &anImage)
     {
-        for (unsigned int i(0); i < min_width; ++i)
+        // The current buffer cannot be re-used
+        if (m_height * m_stride != anImage.m_height * anImage.m_stride)
         {
-            temp.m_p_image[j * temp.m_width + i] -= anImage.m_p_image[j * anImage.m_width + i];
+            // Release memory
+            destroy();
+
+            // Allocate the new buffer
+            m_p_image = allocatePixels(anImage.m_height * anImage.m_stride);
         }
-    }
-    
-    // Return the result
-    return (temp);
-}
 
+        // Copy the image properites
+        m_width   = anImage.m_width;
+        m_height  = anImage.m_height;
+        m_stride  = anImage.m_stride;
 
-//--------------------------------------------
-Image& Image::operator+=(const Image& anImage)
-//--------------------------------------------
-{
-    // Re-use operator+
-    *this = *this + anImage;
-    
-    // Return the result
-    return (*this);
-}
+        // Copy the data (including the padding at the end of the rows)
+        std::copy(anImage.m_p_image, anImage.m_p_image + m_height * m_stride, m_p_image);
 
+        copyStatistics(anImage);
+    }
 
-//--------------------------------------------
-Image& Image::operator-=(const Image& anImage)
-//--------------------------------------------
-{
-    // Re-use operator-
-    *this = *this - anImage;
-    
-    // Return the result
+    // Return the instance
     return (*this);
 }
 
 
-//----------------------------------
-Image Image::operator+(double aValue)
-//----------------------------------
+template <typename T>
+//-----------------------------------------------------
+BasicImage<T>& BasicImage<T>::operator=(BasicImage&& anImage) noexcept
+//-----------------------------------------------------
 {
-    // Copy the instance into a temporary variable
-    Image temp(*this);
-
-    double* p_temp(temp.m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
+    // The images different
+    if (this != &anImage)
     {
-        *p_temp++ += aValue;
-    }
-    
-    // Return the result
-    return (temp);
-}
-
-
-//----------------------------------
-Image Image::operator-(double aValue)
-//----------------------------------
-{
-    // Copy the instance into a temporary variable
-    Image temp(*this);
+        // Release memory
+        releaseAligned(m_p_image);
 
-    double* p_temp(temp.m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ -= aValue;
+        // Take the ownership of the pixel data
+        m_width   = anImage.m_width;
+        m_height  = anImage.m_height;
+        m_stride  = anImage.m_stride;
+        m_p_image = anImage.m_p_image;
+        m_statistics = anImage.m_statistics;
+        m_statistics_valid = anImage.m_statistics_valid.load();
+
+        // The other image is now empty
+        anImage.m_width   = 0;
+        anImage.m_height  = 0;
+        anImage.m_stride  = 0;
+        anImage.m_p_image = 0;
+        anImage.m_statistics_valid = false;
     }
-    
-    // Return the result
-    return (temp);
+
+    // Return the instance
+    return (*this);
 }
 
 
-//----------------------------------
-Image Image::operator*(double aValue)
-//----------------------------------
+template <typename T>
+//--------------------------------------------
+BasicImage<T>& BasicImage<T>::operator+=(const BasicImage& anImage)
+//--------------------------------------------
 {
-    // Copy the instance into a temporary variable
-    Image temp(*this);
-
-    double* p_temp(temp.m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ *= aValue;
-    }
-    
-    // Return the result
-    return (temp);
+    // The expression is evaluated in place when the size does not change,
+    // otherwise the result is moved into the instance
+    return (*this = *this + anImage);
 }
 
 
-//----------------------------------
-Image Image::operator/(double aValue)
-//----------------------------------
+template <typename T>
+//--------------------------------------------
+BasicImage<T>& BasicImage<T>::operator-=(const BasicImage& anImage)
+//--------------------------------------------
 {
-    // Division by zero
-    if (std::abs(aValue) < 1.0e-6)
-    {
-        throw "Division by zero.";
-    }
-    
-    // Copy the instance into a temporary variable
-    Image temp(*this);
-
-    double* p_temp(temp.m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ /= aValue;
-    }
-    
-    // Return the result
-    return (temp);
+    // The expression is evaluated in place when the size does not change,
+    // otherwise the result is moved into the instance
+    return (*this = *this - anImage);
 }
 
 
+template <typename T>
 //-----------------------------------
-Image& Image::operator+=(double aValue)
+BasicImage<T>& BasicImage<T>::operator+=(double aValue)
 //-----------------------------------
 {
-    double* p_temp(m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ += aValue;
-    }
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
+
+    // By bands of rows, or through a table
+    mapPixels(*this, *this, [aValue](double aPixel) { return (aPixel + aValue); });
     
     // Return the result
     return (*this);
 }
 
 
+template <typename T>
 //------------------------------------
-Image& Image::operator-=(double aValue)
+BasicImage<T>& BasicImage<T>::operator-=(double aValue)
 //------------------------------------
 {
-    double* p_temp(m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ -= aValue;
-    }
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
+
+    // By bands of rows, or through a table
+    mapPixels(*this, *this, [aValue](double aPixel) { return (aPixel - aValue); });
     
     // Return the result
     return (*this);
 }
 
 
+template <typename T>
 //------------------------------------
-Image& Image::operator*=(double aValue)
+BasicImage<T>& BasicImage<T>::operator*=(double aValue)
 //------------------------------------
 {
-    double* p_temp(m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ *= aValue;
-    }
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
+
+    // By bands of rows, or through a table
+    mapPixels(*this, *this, [aValue](double aPixel) { return (aPixel * aValue); });
     
     // Return the result
     return (*this);
 }
 
 
+template <typename T>
 //------------------------------------
-Image& Image::operator/=(double aValue)
+BasicImage<T>& BasicImage<T>::operator/=(double aValue)
 //------------------------------------
 {
     // Division by zero
@@ -441,68 +963,77 @@ Image& Image::operator/=(double aValue)
         throw "Division by zero.";
     }
     
-    double* p_temp(m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
-    {
-        *p_temp++ /= aValue;
-    }
-    
-    // Return the result
-    return (*this);
-}
-
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
 
-//----------------------
-Image Image::operator!()
-//----------------------
-{
-    // Copy the instance into a temporary variable
-    Image temp(*this);
-
-    double min_value(getMinValue());
-    double max_value(getMaxValue());
-    double range(max_value - min_value);
-    
-    double* p_temp(temp.m_p_image);
-    
-    // Process every pixel
-    for (unsigned int i(0); i < m_width * m_height; ++i, ++p_temp)
-    {
-        // Take care to preserve the dynamic of the image
-        *p_temp = min_value + range * (1.0 - (*p_temp - min_value) / range);
-    }
+    // By bands of rows, or through a table
+    mapPixels(*this, *this, [aValue](double aPixel) { return (aPixel / aValue); });
     
     // Return the result
-    return (temp);
+    return (*this);
 }
 
 
+template <typename T>
 //---------------------------------
-double Image::getAspectRatio() const
+double BasicImage<T>::getAspectRatio() const
 //---------------------------------
 {
     return (double(m_width) / double(m_height));
 }
 
 
+template <typename T>
 //----------------------------------
-unsigned int Image::getWidth() const
+unsigned int BasicImage<T>::getWidth() const
 //----------------------------------
 {
     return (m_width);
 }
 
 
+template <typename T>
+//----------------------------------
+unsigned int BasicImage<T>::getStride() const
+//----------------------------------
+{
+    return (m_stride);
+}
+
+
+template <typename T>
 //-----------------------------------
-unsigned int Image::getHeight() const
+unsigned int BasicImage<T>::getHeight() const
 //-----------------------------------
 {
     return (m_height);
 }
 
 
+template <typename T>
+//----------------------------------------------
+ImageStatistics BasicImage<T>::getStatistics() const
+//----------------------------------------------
+{
+    // The pixels have changed since the last call: the first thread that
+    // needs the statistics computes them, the others wait for them
+    if (!m_statistics_valid.load(std::memory_order_acquire))
+    {
+        std::lock_guard<std::mutex> lock(m_statistics_mutex);
+        if (!m_statistics_valid.load(std::memory_order_relaxed))
+        {
+            m_statistics = getView().getStatistics();
+            m_statistics_valid.store(true, std::memory_order_release);
+        }
+    }
+
+    return (m_statistics);
+}
+
+
+template <typename T>
 //------------------------------
-double Image::getMinValue() const
+double BasicImage<T>::getMinValue() const
 //------------------------------
 {
     // The image is empty
@@ -511,12 +1042,13 @@ double Image::getMinValue() const
         throw "Empty image";
     }
     // returns min value from image
-    return (*std::min_element(&m_p_image[0], &m_p_image[m_width * m_height]));
+    return (getStatistics().min);
 }
 
 
+template <typename T>
 //------------------------------
-double Image::getMaxValue() const
+double BasicImage<T>::getMaxValue() const
 //------------------------------
 {
     // The image is empty
@@ -525,31 +1057,60 @@ double Image::getMaxValue() const
         throw "Empty image";
     }
     // returns max value from image
-    return (*std::max_element(&m_p_image[0], &m_p_image[m_width * m_height]));
+    return (getStatistics().max);
 }
 
 
+template <typename T>
 //----------------------------------------------------------------
-void Image::shiftScaleFilter(double aShiftValue, double aScaleValue)
+void BasicImage<T>::shiftScaleFilter(double aShiftValue, double aScaleValue)
 //----------------------------------------------------------------
 {
-    // Process every pixel of the image
-    for (unsigned int i = 0; i < m_width * m_height; ++i)
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
+
+    // Process every pixel of the image, by bands of rows or through a table
+    mapPixels(*this, *this, [aShiftValue, aScaleValue](double aPixel) {
         // Apply the shilft/scale filter
-        m_p_image[i] = (m_p_image[i] + aShiftValue) * aScaleValue;
+        return ((aPixel + aShiftValue) * aScaleValue);
+    });
+}
+
+
+template <typename T>
+//----------------------------------------------------------------
+void BasicImage<T>::applyLUT(const LookUpTable<T>& aTable)
+//----------------------------------------------------------------
+{
+    // The pixels change, the statistics are computed again when needed
+    m_statistics_valid = false;
+
+    applyTable(aTable, *this);
 }
 
 
+template <typename T>
+//----------------------------------------------------------------------------------------------------
+bool BasicImage<T>::evaluateThroughTable(const ImageNegationExpression<BasicImageView<T> >& anExpression)
+//----------------------------------------------------------------------------------------------------
+{
+    return (negateThroughTable(anExpression, *this));
+}
+
+
+template <typename T>
 //---------------------
-void Image::normalise()
+void BasicImage<T>::normalise()
 //---------------------
 {
-    shiftScaleFilter(-getMinValue(), 1.0 / (getMaxValue() - getMinValue()));
+    ImageStatistics statistics(getStatistics());
+    shiftScaleFilter(-statistics.min, 1.0 / (statistics.max - statistics.min));
 }
 
 
+template <typename T>
 //----------------------------------------
-void Image::loadPGM(const char* aFileName)
+void BasicImage<T>::loadPGM(const char* aFileName)
 //----------------------------------------
 {
     // Open the file
@@ -574,15 +1135,16 @@ void Image::loadPGM(const char* aFileName)
         // Variable to store a line
         char p_line_data[LINE_SIZE];
     
-        // Get the first line
-        input_file.getline(p_line_data, LINE_SIZE);
-
         // Get the image type
-        std::string image_type(p_line_data);
+        std::string image_type;
+        input_file >> image_type;
     
         // Valid ASCII format
         if (image_type == "P2")
         {
+            // Skip the end of the first line
+            input_file.getline(p_line_data, LINE_SIZE);
+
             // Variable to save the max value
             int max_value(-1);
         
@@ -607,13 +1169,8 @@ void Image::loadPGM(const char* aFileName)
                         stream_line >> m_width >> m_height;
                     
                         // Alocate the memory
-                        m_p_image = new double[m_width * m_height];
-                    
-                        // Out of memory
-                        if (!m_p_image)
-                        {
-                            throw ("Out of memory");
-                        }
+                        m_stride = getDefaultStride(m_width);
+                        m_p_image = allocatePixels(m_height * m_stride);
                     }
                     // The max value is not set
                     else if (max_value < 0)
@@ -633,7 +1190,8 @@ void Image::loadPGM(const char* aFileName)
                             // The pixel exists
                             if (pixel_count < m_width * m_height)
                             {
-                                m_p_image[pixel_count++] = pixel_value;
+                                getRow(pixel_count / m_width)[pixel_count % m_width] = PixelTraits<T>::fromDouble(pixel_value);
+                                ++pixel_count;
                             }
                         }
                     }
@@ -643,68 +1201,73 @@ void Image::loadPGM(const char* aFileName)
         // Valid binary format
         else if (image_type == "P5")
         {
-            // Variable to save the max value
-            int max_value(-1);
+            // The header is made of white-space separated values
+            m_width = readPGMHeaderValue(input_file, aFileName);
+            m_height = readPGMHeaderValue(input_file, aFileName);
+            int max_value(readPGMHeaderValue(input_file, aFileName));
 
-            // There is data to read
-            while (input_file.good())
+            // A single white space separates the header from the pixels
+            input_file.get();
+
+            // Invalid header
+            if (!m_width || !m_height || max_value <= 0 || max_value > 65535)
             {
-            	// Process as an ASCII file
-                if (!m_width || !m_height || max_value < 0)
-                {
-                    // Get the new line
-                    input_file.getline(p_line_data, LINE_SIZE);
+                m_width = m_height = 0;
+
+                // Build the error message
+                std::stringstream error_message;
+                error_message << "Invalid file (\"" << aFileName << "\")";
+
+                // Throw an error
+                throw (error_message.str());
+            }
+
+            // Alocate the memory
+            m_stride = getDefaultStride(m_width);
+            m_p_image = allocatePixels(m_height * m_stride);
 
-                    // It is not a comment
-                    if (p_line_data[0] != '#')
-                    {
-                        // Store the line in a stream
-                        std::stringstream stream_line;
-                        stream_line << std::string(p_line_data);
+            // The values above 255 are stored in 2 bytes, most significant first
+            unsigned int bytes_per_pixel(max_value > 255 ? 2 : 1);
+            std::size_t row_size(std::size_t(m_width) * bytes_per_pixel);
 
-                        // The memory is not allocated
-                        if (!m_p_image && !m_width && !m_height)
-                        {
-                            // Load the image size
-                            stream_line >> m_width >> m_height;
+            // Read all the pixels at once
+            std::vector<unsigned char> p_temp(row_size * m_height);
+            input_file.read(reinterpret_cast<char*>(p_temp.data()), p_temp.size());
 
-                            // Alocate the memory
-                            m_p_image = new double[m_width * m_height];
+            // The file is too short
+            if (std::size_t(input_file.gcount()) != p_temp.size())
+            {
+                destroy();
 
-                            // Out of memory
-                            if (!m_p_image)
-                            {
-                                throw ("Out of memory");
-                            }
-                        }
-                        // The max value is not set
-                        else
-                        {
-                            // Get the max value;
-                            stream_line >> max_value;
-                        }
-                    }
-                }
-                // Read the pixel data
-                else
+                // Build the error message
+                std::stringstream error_message;
+                error_message << "Invalid file (\"" << aFileName << "\")";
+
+                // Throw an error
+                throw (error_message.str());
+            }
+
+            // Convert the pixels, by bands of rows
+            parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+                for (unsigned int j(aFirstRow); j < aLastRow; ++j)
                 {
-                	unsigned char* p_temp(new unsigned char[m_width * m_height]);
+                    const unsigned char* p_input(p_temp.data() + j * row_size);
+                    T* p_output(getRowData(j));
 
-                    // Out of memory
-                    if (!p_temp)
+                    if (bytes_per_pixel == 1)
                     {
-                        throw ("Out of memory");
+                        std::copy(p_input, p_input + m_width, p_output);
+                    }
+                    else
+                    {
+                        for (unsigned int i(0); i < m_width; ++i)
+                        {
+                            p_output[i] = PixelTraits<T>::fromDouble(
+                                    (p_input[2 * i] << 8) | p_input[2 * i + 1]);
+                        }
                     }
-
-                    input_file.read(reinterpret_cast<char*>(p_temp), m_width * m_height);
-
-                	for (unsigned int i(0); i < m_width * m_height; ++i)
-                	{
-                		m_p_image[i] = p_temp[i];
-                	}
-                	delete [] p_temp;
                 }
-            }
+            });
         }
         // Invalid format
         else
@@ -720,20 +1283,23 @@ void Image::loadPGM(const char* aFileName)
 }
 
 
+template <typename T>
 //-----------------------------------------------
-void Image::loadPGM(const std::string& aFileName)
+void BasicImage<T>::loadPGM(const std::string& aFileName)
 //-----------------------------------------------
 {
     loadPGM(aFileName.data());
 }
 
 
+template <typename T>
 //----------------------------------------
-void Image::savePGM(const char* aFileName)
+void BasicImage<T>::savePGM(const char* aFileName, PGMFormat aFormat) const
 //----------------------------------------
 {
     // Open the file
-    std::ofstream output_file(aFileName);
+    std::ofstream output_file(aFileName, aFormat == PGM_BINARY ?
+            std::ofstream::out | std::ofstream::binary : std::ofstream::out);
     
     // The file does not exist
     if (!output_file.is_open())
@@ -745,7 +1311,54 @@ void Image::savePGM(const char* aFileName)
         // Throw an error
         throw (error_message.str());
     }
-    // The file is open
+    // Binary format
+    else if (aFormat == PGM_BINARY)
+    {
+        // 16-bit values when the pixels do not fit in 8 bits
+        bool wide(sizeof(T) > 1 && (PixelTraits<T>::IS_INTEGER || getMaxValue() > 255.0));
+        unsigned int bytes_per_pixel(wide ? 2 : 1);
+
+        // The header
+        std::stringstream header;
+        header << "P5\n";
+        header << "# ICP3038 -- Assignment 1 -- 2016/2017\n";
+        header << m_width << " " << m_height << "\n";
+        header << (wide ? 65535 : 255) << "\n";
+        std::string header_text(header.str());
+
+        // The header and the pixels are written at once
+        std::size_t row_size(std::size_t(m_width) * bytes_per_pixel);
+        std::vector<char> p_buffer(header_text.size() + row_size * m_height);
+        std::copy(header_text.begin(), header_text.end(), p_buffer.begin());
+
+        // Convert the pixels, by bands of rows
+        parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+            for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+            {
+                const T* p_input(getRow(j));
+                unsigned char* p_output(reinterpret_cast<unsigned char*>(
+                        p_buffer.data() + header_text.size() + j * row_size));
+
+                for (unsigned int i(0); i < m_width; ++i)
+                {
+                    // Most significant byte first
+                    if (wide)
+                    {
+                        std::uint16_t pixel_value(PixelTraits<std::uint16_t>::fromDouble(p_input[i]));
+                        p_output[2 * i] = pixel_value >> 8;
+                        p_output[2 * i + 1] = pixel_value & 0xFF;
+                    }
+                    else
+                    {
+                        p_output[i] = PixelTraits<std::uint8_t>::fromDouble(p_input[i]);
+                    }
+                }
+            }
+        });
+
+        output_file.write(p_buffer.data(), p_buffer.size());
+    }
+    // ASCII format
     else
     {
         // Set the image type
@@ -761,46 +1374,67 @@ void Image::savePGM(const char* aFileName)
         //output_file << std::min(255, std::max(0, int(getMaxValue()))) << std::endl;
         output_file << std::max(255, int(getMaxValue())) << std::endl;
     
-        // Process every line
-        for (unsigned int j = 0; j < m_height; ++j)
+        // The text of the rows is built in parallel, by blocks of rows
+        const unsigned int block_size(256);
+        std::vector<std::string> p_row_text(std::min(block_size, m_height));
+        for (unsigned int first_row(0); first_row < m_height; first_row += block_size)
         {
-            // Process every column
-            for (unsigned int i = 0; i < m_width; ++i)
-            {
-                // Process the pixel
-                int pixel_value(m_p_image[j * m_width + i]);
-                pixel_value = std::max(0, pixel_value);
-                pixel_value = std::min(255, pixel_value);
-            
-                output_file << pixel_value;
-            
-                // It is not the last pixel of the line
-                if (i < (m_width - 1))
+            unsigned int number_of_rows(std::min(block_size, m_height - first_row));
+
+            parallelForRows(number_of_rows, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+                for (unsigned int k(aFirstRow); k < aLastRow; ++k)
                 {
-                    output_file << " ";
+                    unsigned int j(first_row + k);
+                    const T* p_input(getRow(j));
+                    std::string& text(p_row_text[k]);
+                    text.clear();
+
+                    // Process every column
+                    for (unsigned int i = 0; i < m_width; ++i)
+                    {
+                        // Process the pixel
+                        int pixel_value(p_input[i]);
+                        pixel_value = std::max(0, pixel_value);
+                        pixel_value = std::min(255, pixel_value);
+
+                        appendInteger(text, pixel_value);
+
+                        // It is not the last pixel of the line
+                        if (i < (m_width - 1))
+                        {
+                            text += ' ';
+                        }
+                    }
+
+                    // It is not the last line of the image
+                    if (j < (m_height - 1))
+                    {
+                        text += '\n';
+                    }
                 }
-            }
-        
-            // It is not the last line of the image
-            if (j < (m_height - 1))
+            });
+
+            for (unsigned int k(0); k < number_of_rows; ++k)
             {
-                output_file << std::endl;
+                output_file.write(p_row_text[k].data(), p_row_text[k].size());
             }
         }
     }
 }
 
 
+template <typename T>
 //-----------------------------------------------
-void Image::savePGM(const std::string& aFileName)
+void BasicImage<T>::savePGM(const std::string& aFileName, PGMFormat aFormat) const
 //-----------------------------------------------
 {
-    savePGM(aFileName.data());
+    savePGM(aFileName.data(), aFormat);
 }
 
 
+template <typename T>
 //----------------------------------------
-void Image::loadRaw(const char* aFileName,
+void BasicImage<T>::loadRaw(const char* aFileName,
                     unsigned int aWidth,
                     unsigned int aHeight)
 //----------------------------------------
@@ -823,7 +1457,7 @@ void Image::loadRaw(const char* aFileName,
     unsigned int size(input_file.tellg());
 
     // The size is not correct
-    if (aWidth * aHeight * sizeof(double) != size)
+    if (aWidth * aHeight * sizeof(T) != size)
     {
         std::stringstream error_message;
         error_message << "The size of " << aFileName << " is not " <<
@@ -841,15 +1475,20 @@ void Image::loadRaw(const char* aFileName,
     // Allocate memory for file content
     m_width = aWidth;
     m_height = aHeight;
-    m_p_image = new double[m_width * m_height];
+    m_stride = getDefaultStride(m_width);
+    m_p_image = allocatePixels(m_height * m_stride);
 
-    // Read content of input_file
-    input_file.read(reinterpret_cast<char*>(m_p_image), size);
+    // Read content of input_file, one row at a time
+    for (unsigned int j(0); j < m_height; ++j)
+    {
+        input_file.read(reinterpret_cast<char*>(getRow(j)), m_width * sizeof(T));
+    }
 }
 
 
+template <typename T>
 //-----------------------------------------------
-void Image::loadRaw(const std::string& aFileName,
+void BasicImage<T>::loadRaw(const std::string& aFileName,
                     unsigned int aWidth,
                     unsigned int aHeight)
 //-----------------------------------------------
@@ -858,8 +1497,9 @@ void Image::loadRaw(const std::string& aFileName,
 }
 
 
+template <typename T>
 //----------------------------------------
-void Image::saveRaw(const char* aFileName)
+void BasicImage<T>::saveRaw(const char* aFileName) const
 //----------------------------------------
 {
     // Open the file in binary
@@ -875,25 +1515,30 @@ void Image::saveRaw(const char* aFileName)
         throw error_message;
     }
 
-    // Write content to file
-    output_file.write(reinterpret_cast<char*>(m_p_image), m_width * m_height * sizeof(double));
+    // Write content to file, without the padding at the end of the rows
+    for (unsigned int j(0); j < m_height; ++j)
+    {
+        output_file.write(reinterpret_cast<const char*>(getRow(j)), m_width * sizeof(T));
+    }
 }
 
 
+template <typename T>
 //-----------------------------------------------
-void Image::saveRaw(const std::string& aFileName)
+void BasicImage<T>::saveRaw(const std::string& aFileName) const
 //-----------------------------------------------
 {
     saveRaw(aFileName.data());
 }
 
 
+template <typename T>
 //------------------------------------------
-void Image::loadASCII(const char* aFileName)
+void BasicImage<T>::loadASCII(const char* aFileName)
 //------------------------------------------
 {
     // Open the file
-    std::ifstream input_file (aFileName);
+    std::ifstream input_file (aFileName, std::ifstream::binary);
 
     // The file is not open
     if (!input_file.is_open())
@@ -905,29 +1550,74 @@ void Image::loadASCII(const char* aFileName)
         throw error_message;
     }
 
-    // Load the data into a vector
-    std::vector<double> p_data;
-    std::string line;
-    int number_of_rows(0);
-    int number_of_columns(0);
+    // Read the whole file at once, followed by a null character
+    input_file.seekg(0, input_file.end);
+    std::size_t size(input_file.tellg());
+    input_file.seekg(0);
+
+    std::vector<char> p_text(size + 1, '\0');
+    input_file.read(p_text.data(), size);
+    const char* p_end(p_text.data() + size);
+
+    // Split the lines, a new line at the end of the file does not start a row
+    std::vector<const char*> p_line_set;
+    for (const char* p_line(p_text.data()); p_line < p_end;)
+    {
+        p_line_set.push_back(p_line);
+
+        const char* p_new_line(static_cast<const char*>(std::memchr(p_line, '\n', p_end - p_line)));
+        p_line = p_new_line ? p_new_line + 1 : p_end;
+    }
+    p_line_set.push_back(p_end);
+
+    unsigned int number_of_rows(p_line_set.size() - 1);
 
-    // Read evely line
-    while (std::getline(input_file, line))
+    // The width is the number of values of the first row
+    unsigned int number_of_columns(0);
+    if (number_of_rows)
     {
-        number_of_columns = 0;
         double intensity;
-        std::stringstream line_parser;
-        line_parser << line;
-        while (line_parser >> intensity)
+        const char* p_value(p_line_set[0]);
+        while ((p_value = parseASCIIValue(p_value, p_line_set[1], intensity)))
         {
-            p_data.push_back(intensity);
             ++number_of_columns;
         }
-        ++number_of_rows;
     }
 
+    // Parse the rows, by bands of rows
+    BasicImage image(number_of_columns, number_of_rows);
+    std::vector<unsigned char> p_valid_row_set(number_of_rows, 1);
+    parallelForRows(number_of_rows, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            T* p_temp(image.getRow(j));
+            const char* p_value(p_line_set[j]);
+            double intensity;
+
+            for (unsigned int i(0); i < number_of_columns; ++i)
+            {
+                p_value = parseASCIIValue(p_value, p_line_set[j + 1], intensity);
+
+                // The row is too short
+                if (!p_value)
+                {
+                    p_valid_row_set[j] = 0;
+                    break;
+                }
+
+                p_temp[i] = PixelTraits<T>::fromDouble(intensity);
+            }
+
+            // The row is too long
+            if (p_value && parseASCIIValue(p_value, p_line_set[j + 1], intensity))
+            {
+                p_valid_row_set[j] = 0;
+            }
+        }
+    });
+
     // Wrong number of pixels
-    if (number_of_rows * number_of_columns != p_data.size())
+    if (std::find(p_valid_row_set.begin(), p_valid_row_set.end(), 0) != p_valid_row_set.end())
     {
         std::string error_message("The file (");
         error_message += aFileName;
@@ -936,29 +1626,22 @@ void Image::loadASCII(const char* aFileName)
         throw error_message;
     }
 
-    // Release the memory
-    destroy();
-
-    // Allocate memory for file content
-    m_width = number_of_columns;
-    m_height = number_of_rows;
-    m_p_image = new double[m_width * m_height];
-
-    // Copy the data
-    std::copy(p_data.begin(), p_data.end(), m_p_image);
+    *this = std::move(image);
 }
 
 
+template <typename T>
 //-------------------------------------------------
-void Image::loadASCII(const std::string& aFileName)
+void BasicImage<T>::loadASCII(const std::string& aFileName)
 //-------------------------------------------------
 {
     loadASCII(aFileName.data());
 }
 
 
+template <typename T>
 //------------------------------------------
-void Image::saveASCII(const char* aFileName)
+void BasicImage<T>::saveASCII(const char* aFileName) const
 //------------------------------------------
 {
     // Open the file
@@ -975,12 +1658,14 @@ void Image::saveASCII(const char* aFileName)
     }
 
     // Write content to file
-    double* p_data(m_p_image);
     for (unsigned int j(0); j < m_height; ++j)
     {
+        const T* p_data(getRow(j));
+
         for (unsigned int i(0); i < m_width; ++i)
         {
-            output_file << *p_data++;
+            // Print the value as a number, even for 8-bit pixels
+            output_file << double(*p_data++);
 
             // This is not the last pixel of the line
             if (i < m_width - 1)
@@ -998,16 +1683,18 @@ void Image::saveASCII(const char* aFileName)
 }
 
 
+template <typename T>
 //-------------------------------------------------
-void Image::saveASCII(const std::string& aFileName)
+void BasicImage<T>::saveASCII(const std::string& aFileName) const
 //-------------------------------------------------
 {
     saveASCII(aFileName.data());
 }
 
 
+template <typename T>
 //------------------------------------------------
-bool Image::operator==(const Image& anImage) const
+bool BasicImage<T>::operator==(const BasicImage& anImage) const
 //------------------------------------------------
 {
     if (m_width != anImage.m_width)
@@ -1020,13 +1707,17 @@ bool Image::operator==(const Image& anImage) const
         return (false);
     }
 
-    double const * p_data1(m_p_image);
-    double const * p_data2(anImage.m_p_image);
-    for (unsigned int i(0); i < m_width * m_height; ++i)
+    for (unsigned int j(0); j < m_height; ++j)
     {
-        if (std::abs(*p_data1++ - *p_data2++) > 1.0e-6)
+        T const * p_data1(getRow(j));
+        T const * p_data2(anImage.getRow(j));
+
+        for (unsigned int i(0); i < m_width; ++i)
         {
-            return (false);
+            if (std::abs(double(p_data1[i]) - double(p_data2[i])) > 1.0e-6)
+            {
+                return (false);
+            }
         }
     }
 
@@ -1034,524 +1725,412 @@ bool Image::operator==(const Image& anImage) const
 }
 
 
+template <typename T>
 //------------------------------------------------
-bool Image::operator!=(const Image& anImage) const
+bool BasicImage<T>::operator!=(const BasicImage& anImage) const
 //------------------------------------------------
 {
     return (!(operator==(anImage)));
 }
 
 
+template <typename T>
 //----------------------------
-Image Image::abs(const Image& aImage)
+BasicImage<T> BasicImage<T>::abs(const BasicImage& aImage)
 //----------------------------
 {
     // If image is empty
     if(!aImage.m_p_image)
         throw "Image Empty";
     
-    Image tempImage(m_width, m_height);
+    BasicImage tempImage(aImage.m_width, aImage.m_height);
     
-    for(int row(0);row<m_height;row++)
-        for(int col(0);col<m_width;col++)
-            // Add pixels from x and y sobel images together
-            tempImage.setPixel(col,row, std::abs(aImage.getPixel(col, row)));
+    // Store the absolute value of every pixel, by bands of rows
+    parallelForRows(aImage.m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for(unsigned int j(aFirstRow); j < aLastRow; j++)
+        {
+            const T* p_data(aImage.getRow(j));
+            T* p_temp(tempImage.getRowData(j));
+
+            for(unsigned int i(0); i < aImage.m_width; i++)
+                p_temp[i] = PixelTraits<T>::fromDouble(std::abs(double(p_data[i])));
+        }
+    });
     
     return tempImage;
 }
 
 
+template <typename T>
 //----------------------------
-double Image::getSum() const
+BasicImage<T> BasicImage<T>::abs(BasicImage&& aImage)
 //----------------------------
 {
     // If image is empty
-    if(!m_p_image)
+    if(!aImage.m_p_image)
         throw "Image Empty";
     
-    double pixelSum = 0;
+    // The pixels change, the statistics are computed again when needed
+    aImage.m_statistics_valid = false;
+
+    // Replace every pixel by its absolute value in place, by bands of rows
+    parallelForRows(aImage.m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for(unsigned int j(aFirstRow); j < aLastRow; j++)
+        {
+            T* p_temp(aImage.getRowData(j));
+
+            for(unsigned int i(0); i < aImage.m_width; i++)
+                p_temp[i] = PixelTraits<T>::fromDouble(std::abs(double(p_temp[i])));
+        }
+    });
     
-    // Adds all pixel values into varaible
-    for(unsigned int i(0); i<m_width*m_height; i++)
-        pixelSum += m_p_image[i];
+    // Transfer the pixel data to the result
+    return std::move(aImage);
+}
+
 
-    return pixelSum;
+template <typename T>
+//----------------------------
+double BasicImage<T>::getSum() const
+//----------------------------
+{
+    return (getStatistics().sum);
 }
 
 
+template <typename T>
 //--------------------------------
-double Image::getAverage() const
+double BasicImage<T>::getAverage() const
 //--------------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    
-    // Sum of image pixels divided by
-    // amount of pixels
-    return getSum() / (m_height * m_width);
+    return (getStatistics().mean);
 }
 
 
+template <typename T>
 //---------------------------------
-double Image::getVariance() const
+double BasicImage<T>::getVariance() const
 //---------------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    
-    double avg = getAverage();
-    double variance = 0;
-    
-    // Loop through each pixel
-    for(unsigned int i(0); i<m_width * m_height; i++)
-        // Subtract images pixel by mean and multiply agaisnt each other
-        variance += (m_p_image[i] - avg) * (m_p_image[i] - avg);
-    
-    // Divide the Sum by the image size to get variance
-    return ( variance / (m_height * m_width) );
+    return (getStatistics().variance);
 }
 
 
+template <typename T>
 //------------------------------------------
-double Image::getStandardDeviation() const
+double BasicImage<T>::getStandardDeviation() const
 //------------------------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    
-    double avg = getAverage();
-    double standardDeviation = 0.0;
-    
-    // Loop through each pixel and store the standard deviation
-    for(unsigned int i(0); i < m_height*m_width; i++)
-        standardDeviation += pow(m_p_image[i] - avg, 2);
-
-    return sqrt(standardDeviation / (m_height * m_width) ) ;
+    return (getStatistics().standardDeviation);
 }
 
 
+template <typename T>
 //------------------------------------------------
-double Image::computeSAE(const Image& aImage) const
+double BasicImage<T>::computeSAE(const BasicImage& aImage) const
 //------------------------------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    else if(!aImage.m_p_image)
-        throw "aImage Empty";
-    
-    double saeValue = 0.0;
-    
-    // Loop through each pixel of two images
-    for (unsigned int i(0); i < (m_height*m_width); i++)
-        // Minus from each other, store absoutle value
-        saeValue += std::abs(m_p_image[i] - aImage.m_p_image[i]);
-    
-    return saeValue;
+    return (getView().computeSAE(aImage.getView()));
+}
+
+
+template <typename T>
+//-----------------------------------------------------------------------
+double BasicImage<T>::computeSAE(const BasicImageView<T>& aView) const
+//-----------------------------------------------------------------------
+{
+    return (getView().computeSAE(aView));
 }
 
 
+template <typename T>
 //------------------------------------------------
-double Image::computeNCC(const Image& aImage) const
+double BasicImage<T>::computeNCC(const BasicImage& aImage) const
 //------------------------------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    else if(!aImage.m_p_image)
-        throw "aImage Empty";
-    
-    double nccValue = 0.0;
-    
-    // Mean for both images
-    double avg1 = getAverage();
-    double avg2 = aImage.getAverage();
-    
-    // Standard Deviation for both images
-    double stanDev1 = getStandardDeviation();
-    double stanDev2 = aImage.getStandardDeviation();
-    
-    // Loop through each pixel of two images
-    for (int i = 0; i < (m_height*m_width); i++)
-        // Calcualting ncc value
-        nccValue += (( (m_p_image[i] - avg1) * (aImage.m_p_image[i] - avg2) ) / (stanDev1 * stanDev2));
-    
-    return nccValue/ (m_height * m_width) ;
+    return (getView().computeNCC(aImage.getView()));
+}
+
+
+template <typename T>
+//-----------------------------------------------------------------------
+double BasicImage<T>::computeNCC(const BasicImageView<T>& aView) const
+//-----------------------------------------------------------------------
+{
+    return (getView().computeNCC(aView));
 }
 
 
+template <typename T>
 //---------------------------
-Image Image::convolution(double kernelArray[])
+BasicImage<T> BasicImage<T>::convolution(double kernelArray[]) const
 //---------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    
-    Image tempImage(m_width, m_height);
-    
-    double kernelValue;
-    double imageValue;
-    double pixelValue;
-    double pixelSum;
-    
-    // Store current (kernel index + imageindex) for row and column, respectively
-    int tempRow,tempCol;
-    
-    // Move kernel through all pixels of the image
-    for(int row(0); row < m_height; row++)
-        for(int col(0); col < m_width; col++) {
-            
-            pixelSum = 0.0;
-            
-            // Move through kernel elements
-            for(int kRow(0);kRow<KERNEL_HEIGHT;kRow++)
-                for(int kCol(0);kCol<KERNEL_WIDTH;kCol++) {
-                    // Image index plus kernel index - Row, Coloumn
-                    tempRow = (kRow - 1) + row;
-                    tempCol = (kCol - 1) + col;
-                    
-                    // If a index is less than 0
-                    // Resets to 0
-                    if (tempRow < 0 && tempCol < 0){
-                        tempRow = 0;
-                        tempCol = 0;
-                    } else if (tempRow < 0)
-                        tempRow = 0;
-                    else if (tempCol < 0)
-                        tempCol = 0;
-                    
-                    // If a index is greater than the image size
-                    // set to highest
-                    if(tempRow >= m_height && tempCol >= m_width){
-                        tempRow = m_height -1;
-                        tempCol = m_width-1;
-                    }else if (tempRow >=m_height)
-                        tempRow = m_height -1;
-                    else if (tempCol >=m_width)
-                        tempCol = m_width-1;
-                    
-                    // multiply pixel value with corresponding kernal value
-                    kernelValue = kernelArray[kCol * KERNEL_WIDTH + kRow];
-                    imageValue = m_p_image[tempRow * m_width + tempCol];
-                    pixelValue = kernelValue * imageValue;
-                    pixelSum += pixelValue;
-                }
-            
-            
-            // Assign kernel value to pixel
-            tempImage.setPixel(col, row, pixelSum);
-        }
-    
-    return tempImage;
+    return (getView().convolution(kernelArray));
 }
 
 
-//------------------------
-Image Image::medianFilter()
-//------------------------
+template <typename T>
+//---------------------------------------------------------------------------
+BasicImage<T> BasicImage<T>::convolution(const Kernel& aKernel,
+                                         ConvolutionMethod aMethod,
+                                         BorderPolicy aBorder,
+                                         double aBorderValue) const
+//---------------------------------------------------------------------------
 {
-    // If image is empty
-    if(!m_p_image)
-        throw "Image Empty";
-    
-    Image tempImage(m_width, m_height);
-    
-    std::vector<double> kernel;
-    
-    // Store current (kernel index + imageindex) for row and column, respectively
-    int tempRow, tempCol;
-    
-    // Move kernel through all pixels of the image
-    for (int row(0);row<m_height;row++) {
-        for(int col(0);col<m_width;col++) {
-            
-            //   Pick up kernel elements
-            for (int kRow(row - 1); kRow < row + 2; kRow++)
-                for (int kCol(col - 1); kCol < col + 2; kCol++){
- 
-                    // If the kernel value is within the image
-                    // Store image pixel value with corresponding kernal value
-                    tempRow = kRow;
-                    tempCol = kCol;
-                    
-                    
-                    // If a index is less than 0
-                    // Resets to 0
-                    if (tempRow < 0 && tempCol < 0){
-                        tempRow = 0;
-                        tempCol = 0;
-                    } else if (tempRow < 0)
-                        tempRow = 0;
-                    else if (tempCol < 0)
-                        tempCol = 0;
-                    
-                    
-                    // If a index is greater than the image size
-                    // set to highest
-                    if(tempRow >= m_height && tempCol >= m_width){
-                        tempRow = m_height -1;
-                        tempCol = m_width-1;
-                    }else if (tempRow >=m_height)
-                        tempRow = m_height -1;
-                    else if (tempCol >=m_width)
-                        tempCol = m_width-1;
-                    
-                    // Holds values within kernel indexs
-                    kernel.push_back( m_p_image[tempRow * m_width + tempCol] );
-                }
-            
-            // Sort vector
-            std::sort(kernel.begin(), kernel.end());
-            
-            // Assign window median to pixel
-            tempImage.setPixel(col, row, kernel[round(kernel.size()/2)]);
-            
-            // Empty Vector
-            kernel.clear();
-        }
-    }
-    
-    return tempImage;
+    return (getView().convolution(aKernel, aMethod, aBorder, aBorderValue));
 }
 
 
+template <typename T>
+//---------------------------------------------------------------------------
+BasicImage<T> BasicImage<T>::gradient(GradientOperator anOperator,
+                                      GradientMagnitude aMagnitude,
+                                      BasicImage<double>* apOrientation,
+                                      BorderPolicy aBorder,
+                                      double aBorderValue) const
+//---------------------------------------------------------------------------
+{
+    return (getView().gradient(anOperator, aMagnitude, apOrientation, aBorder, aBorderValue));
+}
+
+
+template <typename T>
+//-----------------------------------------------------------------------------
+BasicImage<T> BasicImage<T>::medianFilter(BorderPolicy aBorder, double aBorderValue) const
+//-----------------------------------------------------------------------------
+{
+    return (getView().medianFilter(aBorder, aBorderValue));
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImage<T>::medianFilter(unsigned int aRadius,
+                                          BorderPolicy aBorder,
+                                          double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    return (getView().medianFilter(aRadius, aBorder, aBorderValue));
+}
+
+
+template <typename T>
 //---------------------------
-Image Image::gaussianFilter()
+BasicImage<T> BasicImage<T>::gaussianFilter() const
 //---------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
     
-    Image tempImage(m_width, m_height);
-    
     double gaussianKernel[] = {1, 2, 1,
                                 2, 4, 2,
                                 1, 2, 1};
     
-    // Apply gaussian kernel to image
-    tempImage = convolution(gaussianKernel);
-    
-    return (tempImage / 16);
+    // Apply gaussian kernel to image,
+    // the normalisation is done before rounding integer pixels
+    return (BasicImage(getView().template convolve<double>(gaussianKernel) / 16));
 }
 
 
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImage<T>::gaussianFilter(double aSigma,
+                                            BorderPolicy aBorder,
+                                            double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    return (getView().gaussianFilter(aSigma, aBorder, aBorderValue));
+}
+
+
+template <typename T>
 //------------------------
-Image Image::meanFilter()
+BasicImage<T> BasicImage<T>::meanFilter() const
 //------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
     
-    Image tempImage(m_width, m_height);
-    
-    double meanKernel[] = {1, 1, 1,
-                            1, 1, 1,
-                            1, 1, 1};
-    
-    // Applying box kernel to image
-    tempImage = convolution(meanKernel);
-    
-    return (tempImage / 9);
+    // Box filter of the 3x3 window
+    return (getView().meanFilter(1));
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImage<T>::meanFilter(unsigned int aRadius,
+                                        BorderPolicy aBorder,
+                                        double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    return (getView().meanFilter(aRadius, aBorder, aBorderValue));
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+void BasicImage<T>::getLocalStatistics(unsigned int aRadius,
+                                       BasicImage<double>* apMean,
+                                       BasicImage<double>* apVariance,
+                                       BorderPolicy aBorder,
+                                       double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    getView().getLocalStatistics(aRadius, apMean, apVariance, aBorder, aBorderValue);
 }
 
 
+template <typename T>
 //---------------------------
-Image Image::laplacianFilter()
+BasicImage<T> BasicImage<T>::laplacianFilter() const
 //---------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
 
-    Image tempImage(m_width, m_height);
-    
     double laplacianKernel[] = {0, 1, 0,
                                 1, -4, 1,
                                 0, 1, 0};
     
     // Applying laplacian kernel to image
-    tempImage = convolution(laplacianKernel);
-    
-    return tempImage;
+    return (convolution(laplacianKernel));
 }
 
 
+template <typename T>
 //---------------------------
-Image Image::sobelEdgeDetector()
+BasicImage<T> BasicImage<T>::sobelEdgeDetector() const
 //---------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
     
-    double xSobelKernel[] = {1, 0, -1,
-                             2, 0, -2,
-                             1, 0, -1};
-    
-    double ySobelKernel[] = {1, 2, 1,
-                            0, 0, 0,
-                            -1, -2, -1};
-
-    // Applying both sobel kernels to separate images
-    // Add absoulte values of both images together
-    return abs(convolution(xSobelKernel)) + abs(convolution(ySobelKernel));
+    // Both derivatives and their absolute values in a single pass
+    return (getView().gradient(GRADIENT_SOBEL));
 }
 
 
+template <typename T>
 //---------------------------
-Image Image::prewittEdgeDetector()
+BasicImage<T> BasicImage<T>::prewittEdgeDetector() const
 //---------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
     
-    double xPrewittKernel[] = {-1, 0, 1,
-                               -1, 0, 1,
-                               -1, 0, 1};
-    
-    double yPrewittKernel[] = {-1, -1, -1,
-                                0, 0, 0,
-                                1, 1, 1};
-    
-    // Applying both sobel kernels to separate images
-    // Add absoulte values of both images together
-    return abs(convolution(xPrewittKernel)) + abs(convolution(yPrewittKernel));
+    // Both derivatives and their absolute values in a single pass
+    return (getView().gradient(GRADIENT_PREWITT));
 }
 
 
+template <typename T>
 //------------------------------------------
-Image Image::sharpening(double sharpenValue)
+BasicImage<T> BasicImage<T>::sharpening(double sharpenValue,
+                                        unsigned int aRadius,
+                                        double aThreshold) const
 //------------------------------------------
 {
-    Image originalImage(m_p_image, m_width, m_height);
-    
-    // Get image detail
-    Image gaussianImage = originalImage.gaussianFilter();
-    Image imageDetail = originalImage - gaussianImage;
-    
-    //Sharpen detail
-    imageDetail *= sharpenValue;
-    
-    //return image with sharpened image
-    return (originalImage + imageDetail);
+    // If image is empty
+    if(!m_p_image)
+        throw "Image Empty";
+
+    // Blur, detail and sum in a single pass
+    return (getView().sharpen(sharpenValue, aRadius, aThreshold));
 }
 
 
+template <typename T>
 //-----------------------------------------------------------------
-Image Image::segmentationThresholding(double thresholdValue)
+BasicImage<T> BasicImage<T>::segmentationThresholding(double thresholdValue) const
 //-----------------------------------------------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
     
-    Image tempImage(m_width, m_height);
+    BasicImage tempImage(m_width, m_height);
     
-    //   Move through all elements of the image
-    for (int row(0); row < m_height; row++)
-        for (int col(0); col < m_width; col++)
-            // Assign 0 if below threshold
-            // otherwise assign 1
-            if (m_p_image[row * m_width + col] > thresholdValue)
-                tempImage.setPixel(col, row, 1);
-            else
-                tempImage.setPixel(col, row, 0);
+    //   Move through all elements of the image, by bands of rows or through a table
+    mapPixels(*this, tempImage, [thresholdValue](double aPixel) {
+        // Assign 0 if below threshold
+        // otherwise assign 1
+        return (aPixel > thresholdValue ? 1.0 : 0.0);
+    });
     
     return tempImage;
 }
 
 
 
+template <typename T>
+//-----------------------------------------------------------------
+BinaryImage BasicImage<T>::binaryThresholding(double thresholdValue) const
+//-----------------------------------------------------------------
+{
+    // If image is empty
+    if(!m_p_image)
+        throw "Image Empty";
+
+    return (BinaryImage(getView(), thresholdValue));
+}
+
+
+template <typename T>
 //------------------------------------------------------
-Image Image::blending(const Image& aImage, double alpha)
+BasicImage<T> BasicImage<T>::blending(const BasicImage& aImage, double alpha) const
 //------------------------------------------------------
 {
     if(m_width != aImage.m_width || m_height != aImage.m_height)
         throw "Image Sizes are different";
     
-    Image tempImage(m_width, m_height);
-    double blendValue = 0;
+    BasicImage tempImage(m_width, m_height);
     
-    //   Move through all elements of the image
-    for (int row(0); row < m_height; row++)
-        for (int col(0); col < m_width; col++) {
-            
-            // Multiple pixel from both images by alpha
-            // Add both pixels values together
-            blendValue = (1 - alpha)*getPixel(col, row) + alpha* aImage.getPixel(col, row);
-            
-            tempImage.setPixel(col, row, blendValue);
+    //   Move through all elements of the image, by bands of rows
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; j++) {
+            const T* p_data1(getRow(j));
+            const T* p_data2(aImage.getRow(j));
+            T* p_temp(tempImage.getRowData(j));
+
+            for (unsigned int i(0); i < m_width; i++) {
+        
+                // Multiple pixel from both images by alpha
+                // Add both pixels values together
+                double blendValue = (1 - alpha)*p_data1[i] + alpha* p_data2[i];
+        
+                p_temp[i] = PixelTraits<T>::fromDouble(blendValue);
+            }
         }
+    });
     
     return tempImage;
 }
 
 
+template <typename T>
 //-----------------------------------------------------------------------------
-std::vector<unsigned int> Image::getHistogram(unsigned int aNumberOfBins) const
+std::vector<unsigned int> BasicImage<T>::getHistogram(unsigned int aNumberOfBins) const
 //-----------------------------------------------------------------------------
 {
     // If image is empty
     if(!m_p_image)
         throw "Image Empty";
-    
-    std::vector<unsigned int> p_histogram_data(aNumberOfBins, 0);
-    
-    double binMax = getMaxValue();
-    double binMin = getMinValue();
-    double rangeBin = (binMax - binMin) / aNumberOfBins;
-    
-    // keeps track of bin values
-    double tempBinMin = 0 , tempBinMax = 0;
-    tempBinMax = binMin + rangeBin;
-    
-    for(unsigned int i = 0;  i < (m_height*m_width); i++) {
-
-        
-        // Loops through each bin
-        for (int j = 0; j < aNumberOfBins; j++)
-            // Increase bin if value is within range
-            if (j != aNumberOfBins - 1 ){
-                if( m_p_image[i] >= tempBinMin  && m_p_image[i] < tempBinMax) {
-                    p_histogram_data[j]++;
-                    break;
-                }
-                else {
-                    // If not within range
-                    // Set range for next bin
-                    tempBinMin += rangeBin;
-                    tempBinMax += rangeBin;
-                }
-            }
-            else {
-                // Catch top value in the last bin
-                if( m_p_image[i] >= tempBinMin) {
-                    p_histogram_data[j]++;
-                    break;
-                }
-            }
 
-    
-        
-        // Set bin range
-        tempBinMin = binMin;
-        tempBinMax = binMin + rangeBin;
-    }
-    
-    return p_histogram_data;
+    ImageStatistics statistics(getStatistics());
+    return (getView().getHistogram(aNumberOfBins, statistics.min, statistics.max));
 }
 
 
 
+template <typename T>
 //---------------------------------------------------------------------------------
-void Image::writeHistogram(unsigned int aNumberOfBins, const char* aFileName) const
+void BasicImage<T>::writeHistogram(unsigned int aNumberOfBins, const char* aFileName) const
 //---------------------------------------------------------------------------------
 {
     // If image is empty
@@ -1571,8 +2150,9 @@ void Image::writeHistogram(unsigned int aNumberOfBins, const char* aFileName) co
     else
     {
         // Work out bin range
-        double binMax = getMaxValue();
-        double binMin = getMinValue();
+        ImageStatistics statistics(getStatistics());
+        double binMax = statistics.max;
+        double binMin = statistics.min;
         double rangeBin = (binMax - binMin) / aNumberOfBins;
         
         std::vector<unsigned int> p_histogram_data = getHistogram(aNumberOfBins);
@@ -1589,9 +2169,19 @@ void Image::writeHistogram(unsigned int aNumberOfBins, const char* aFileName) co
 }
 
 
+template <typename T>
 //----------------------------------------------------------------------------------------
-void Image::writeHistogram(unsigned int aNumberOfBins, const std::string& aFileName) const
+void BasicImage<T>::writeHistogram(unsigned int aNumberOfBins, const std::string& aFileName) const
 //----------------------------------------------------------------------------------------
 {
     writeHistogram(aNumberOfBins, aFileName.data());
 }
+
+
+//******************************************************************************
+//  Explicit instantiations
+//******************************************************************************
+template class BasicImage<std::uint8_t>;
+template class BasicImage<std::uint16_t>;
+template class BasicImage<float>;
+template class BasicImage<double>;
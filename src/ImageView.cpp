@@ -0,0 +1,1633 @@
+/**
+********************************************************************************
+*
+*   @file       ImageView.cpp
+*
+*   @brief      Class to access a region of a greyscale image without copy.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <algorithm> // Header file for min/max/sort
+#include <cmath> // Header file for abs/sqrt/atan2/pow
+#include <mutex> // Header file for mutex/lock_guard
+#include <type_traits> // Header file for is_same
+
+#include "ImageView.h"
+#include "Image.h"
+#include "Convolution3x3.h"
+#include "IntegralImage.h"
+#include "RecursiveGaussian.h"
+#include "Spectrum.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Compute the median of 3 values without any branch.
+/**
+* @param a: the first value
+* @param b: the second value
+* @param c: the third value
+* @return the median
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static inline T median3(T a, T b, T c)
+//------------------------------------------------------------------------
+{
+    return (std::max(std::min(a, b), std::min(std::max(a, b), c)));
+}
+
+
+//------------------------------------------------------------------------
+/// Compute the interior of a row of a centred 3x3 convolution with the
+/// vectorised kernel. Only double precision pixels are supported.
+/**
+* @param aView: the input pixels
+* @param aRow: the row (not on the border of the view)
+* @param apKernel: the 9 coefficients of the kernel, row by row
+* @param apOutput: the output row (the first and last pixels are not set)
+* @return true if the row has been computed, false otherwise
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static bool convolveInterior3x3(const BasicImageView<T>&,
+                                int,
+                                const double*,
+                                double*)
+//------------------------------------------------------------------------
+{
+    return (false);
+}
+
+
+//------------------------------------------------------------------------
+static bool convolveInterior3x3(const BasicImageView<double>& aView,
+                                int aRow,
+                                const double* apKernel,
+                                double* apOutput)
+//------------------------------------------------------------------------
+{
+    const double* p_rows[3] = {aView.getRow(aRow - 1), aView.getRow(aRow), aView.getRow(aRow + 1)};
+    convolveRow3x3(p_rows, apKernel, apOutput + 1, aView.getWidth() - 2);
+
+    return (true);
+}
+
+
+//------------------------------------------------------------------------
+/// Copy a view with a frame of aRadius pixels that follows the border
+/// policy. Every window of the filters is then inside the padded copy.
+/**
+* @param aView: the input pixels
+* @param aRadius: the width of the frame
+* @param aBorder: how the pixels outside the view are read
+* @param aBorderValue: the value of the pixels outside the view
+* @param aPadded: the padded copy, (width + 2 * aRadius) pixels per row
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static void copyWithBorder(const BasicImageView<T>& aView,
+                           int aRadius,
+                           BorderPolicy aBorder,
+                           T aBorderValue,
+                           std::vector<T>& aPadded)
+//------------------------------------------------------------------------
+{
+    int width(aView.getWidth());
+    int height(aView.getHeight());
+    int paddedWidth(width + 2 * aRadius);
+
+    aPadded.resize(paddedWidth * (height + 2 * aRadius));
+    parallelForRows(height + 2 * aRadius, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (int row(int(aFirstRow) - aRadius); row < int(aLastRow) - aRadius; row++) {
+            int tempRow(getBorderIndex(row, height, aBorder));
+            T* p_padded(&aPadded[(row + aRadius) * paddedWidth]);
+
+            // The row follows the border policy
+            if (tempRow < 0) {
+                std::fill(p_padded, p_padded + paddedWidth, aBorderValue);
+                continue;
+            }
+
+            const T* p_data(aView.getRow(tempRow));
+            for (int col(0); col < aRadius; col++) {
+                int leftCol(getBorderIndex(col - aRadius, width, aBorder));
+                int rightCol(getBorderIndex(width + col, width, aBorder));
+
+                p_padded[col] = leftCol < 0 ? aBorderValue : p_data[leftCol];
+                p_padded[aRadius + width + col] = rightCol < 0 ? aBorderValue : p_data[rightCol];
+            }
+            std::copy(p_data, p_data + aView.getWidth(), p_padded + aRadius);
+        }
+    });
+}
+
+
+//------------------------------------------------------------------------
+/// Compute the median filter of any radius with a sorted window.
+/// Moving the window by one pixel removes and inserts one column of
+/// the window in the sorted values (floating-point pixels).
+/**
+* @param aPadded: the input pixels, with a frame of aRadius pixels
+* @param aRadius: the radius of the window
+* @param aFirstRow: the first row to compute
+* @param aLastRow: the row after the last row to compute
+* @param anOutput: the filtered image
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static void medianFilterWindow(const std::vector<T>& aPadded,
+                               int aRadius,
+                               int aFirstRow,
+                               int aLastRow,
+                               BasicImage<T>& anOutput)
+//------------------------------------------------------------------------
+{
+    int width(anOutput.getWidth());
+    int diameter(2 * aRadius + 1);
+    int paddedWidth(width + 2 * aRadius);
+
+    std::vector<T> window;
+    window.reserve(diameter * diameter);
+
+    for (int row(aFirstRow); row < aLastRow; row++) {
+        const T* p_top(&aPadded[row * paddedWidth]);
+
+        // Window of the first pixel of the row
+        window.clear();
+        for (int y(0); y < diameter; y++)
+            window.insert(window.end(), p_top + y * paddedWidth, p_top + y * paddedWidth + diameter);
+        std::sort(window.begin(), window.end());
+
+        T* p_output(anOutput.getRow(row));
+        for (int col(0); col < width; col++) {
+
+            // Replace the column that leaves the window by the one that enters it
+            if (col > 0) {
+                for (int y(0); y < diameter; y++) {
+                    const T* p_line(p_top + y * paddedWidth);
+                    window.erase(std::lower_bound(window.begin(), window.end(), p_line[col - 1]));
+                    window.insert(std::upper_bound(window.begin(), window.end(), p_line[col + diameter - 1]),
+                                  p_line[col + diameter - 1]);
+                }
+            }
+
+            p_output[col] = window[window.size() / 2];
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------
+/// Compute the median filter of any radius on 8-bit pixels (Perreault and
+/// Hebert). Every column of the padded image has a histogram of the
+/// diameter pixels around the current row; the histogram of the window is
+/// updated by adding the column that enters it and subtracting the column
+/// that leaves it, so the cost per pixel does not depend on the radius.
+/// The histograms have 16 coarse bins to find the median quickly.
+/**
+* @param aPadded: the input pixels, with a frame of aRadius pixels
+* @param aRadius: the radius of the window
+* @param aFirstRow: the first row to compute
+* @param aLastRow: the row after the last row to compute
+* @param anOutput: the filtered image
+*/
+//------------------------------------------------------------------------
+static void medianFilterWindow(const std::vector<std::uint8_t>& aPadded,
+                               int aRadius,
+                               int aFirstRow,
+                               int aLastRow,
+                               BasicImage<std::uint8_t>& anOutput)
+//------------------------------------------------------------------------
+{
+    int width(anOutput.getWidth());
+    int diameter(2 * aRadius + 1);
+    int paddedWidth(width + 2 * aRadius);
+    unsigned int half(diameter * diameter / 2);
+
+    // Histograms of the columns, fine (256 bins) and coarse (16 bins)
+    std::vector<unsigned int> columnFine(paddedWidth * 256, 0);
+    std::vector<unsigned int> columnCoarse(paddedWidth * 16, 0);
+
+    // Histograms of the window
+    std::vector<unsigned int> windowFine(256);
+    std::vector<unsigned int> windowCoarse(16);
+
+    // The first diameter - 1 rows, the last row is added in the loop
+    for (int y(aFirstRow); y < aFirstRow + diameter - 1; y++)
+        for (int col(0); col < paddedWidth; col++) {
+            std::uint8_t value(aPadded[y * paddedWidth + col]);
+            columnFine[col * 256 + value]++;
+            columnCoarse[col * 16 + (value >> 4)]++;
+        }
+
+    for (int row(aFirstRow); row < aLastRow; row++) {
+
+        // Move the column histograms down by one row
+        const std::uint8_t* p_enter(&aPadded[(row + diameter - 1) * paddedWidth]);
+        for (int col(0); col < paddedWidth; col++) {
+            columnFine[col * 256 + p_enter[col]]++;
+            columnCoarse[col * 16 + (p_enter[col] >> 4)]++;
+        }
+        if (row > aFirstRow) {
+            const std::uint8_t* p_leave(&aPadded[(row - 1) * paddedWidth]);
+            for (int col(0); col < paddedWidth; col++) {
+                columnFine[col * 256 + p_leave[col]]--;
+                columnCoarse[col * 16 + (p_leave[col] >> 4)]--;
+            }
+        }
+
+        // Window of the first pixel of the row
+        std::fill(windowFine.begin(), windowFine.end(), 0);
+        std::fill(windowCoarse.begin(), windowCoarse.end(), 0);
+        for (int col(0); col < diameter; col++) {
+            for (int bin(0); bin < 256; bin++)
+                windowFine[bin] += columnFine[col * 256 + bin];
+            for (int bin(0); bin < 16; bin++)
+                windowCoarse[bin] += columnCoarse[col * 16 + bin];
+        }
+
+        std::uint8_t* p_output(anOutput.getRow(row));
+        for (int col(0); col < width; col++) {
+
+            // Add the column that enters the window, subtract the one that leaves it
+            if (col > 0) {
+                const unsigned int* p_enterFine(&columnFine[(col + diameter - 1) * 256]);
+                const unsigned int* p_leaveFine(&columnFine[(col - 1) * 256]);
+                for (int bin(0); bin < 256; bin++)
+                    windowFine[bin] += p_enterFine[bin] - p_leaveFine[bin];
+
+                const unsigned int* p_enterCoarse(&columnCoarse[(col + diameter - 1) * 16]);
+                const unsigned int* p_leaveCoarse(&columnCoarse[(col - 1) * 16]);
+                for (int bin(0); bin < 16; bin++)
+                    windowCoarse[bin] += p_enterCoarse[bin] - p_leaveCoarse[bin];
+            }
+
+            // Find the coarse bin of the median, then the value in this bin
+            unsigned int count(0);
+            int coarse(0);
+            while (count + windowCoarse[coarse] <= half)
+                count += windowCoarse[coarse++];
+
+            int fine(coarse * 16);
+            while (count + windowFine[fine] <= half)
+                count += windowFine[fine++];
+
+            p_output[col] = fine;
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------
+/// Compute the median filter of any radius on 16-bit pixels (Huang).
+/// The histogram of the window is updated by removing the pixels of the
+/// column that leaves it and adding those of the column that enters it.
+/// The histogram has 256 coarse bins to find the median quickly.
+/**
+* @param aPadded: the input pixels, with a frame of aRadius pixels
+* @param aRadius: the radius of the window
+* @param aFirstRow: the first row to compute
+* @param aLastRow: the row after the last row to compute
+* @param anOutput: the filtered image
+*/
+//------------------------------------------------------------------------
+static void medianFilterWindow(const std::vector<std::uint16_t>& aPadded,
+                               int aRadius,
+                               int aFirstRow,
+                               int aLastRow,
+                               BasicImage<std::uint16_t>& anOutput)
+//------------------------------------------------------------------------
+{
+    int width(anOutput.getWidth());
+    int diameter(2 * aRadius + 1);
+    int paddedWidth(width + 2 * aRadius);
+    unsigned int half(diameter * diameter / 2);
+
+    // Histograms of the window, fine (65536 bins) and coarse (256 bins)
+    std::vector<unsigned int> windowFine(65536, 0);
+    std::vector<unsigned int> windowCoarse(256, 0);
+
+    for (int row(aFirstRow); row < aLastRow; row++) {
+        const std::uint16_t* p_top(&aPadded[row * paddedWidth]);
+
+        // Window of the first pixel of the row
+        for (int y(0); y < diameter; y++)
+            for (int x(0); x < diameter; x++) {
+                std::uint16_t value(p_top[y * paddedWidth + x]);
+                windowFine[value]++;
+                windowCoarse[value >> 8]++;
+            }
+
+        std::uint16_t* p_output(anOutput.getRow(row));
+        for (int col(0); col < width; col++) {
+
+            // Replace the column that leaves the window by the one that enters it
+            if (col > 0) {
+                for (int y(0); y < diameter; y++) {
+                    std::uint16_t leave(p_top[y * paddedWidth + col - 1]);
+                    std::uint16_t enter(p_top[y * paddedWidth + col + diameter - 1]);
+                    windowFine[leave]--;
+                    windowCoarse[leave >> 8]--;
+                    windowFine[enter]++;
+                    windowCoarse[enter >> 8]++;
+                }
+            }
+
+            // Find the coarse bin of the median, then the value in this bin
+            unsigned int count(0);
+            int coarse(0);
+            while (count + windowCoarse[coarse] <= half)
+                count += windowCoarse[coarse++];
+
+            int fine(coarse * 256);
+            while (count + windowFine[fine] <= half)
+                count += windowFine[fine++];
+
+            p_output[col] = fine;
+        }
+
+        // Empty the histograms (cheaper than clearing the 65536 bins)
+        for (int y(0); y < diameter; y++)
+            for (int x(width - 1); x < width - 1 + diameter; x++) {
+                std::uint16_t value(p_top[y * paddedWidth + x]);
+                windowFine[value]--;
+                windowCoarse[value >> 8]--;
+            }
+    }
+}
+
+
+//------------------------------------------------------------------------
+/// Convert a position in a histogram (in number of bins from the lower
+/// bound) to a bin, the values outside the bounds go to the end bins.
+/**
+* @param aPosition: the position
+* @param aNumberOfBins: the number of bins
+* @return the index of the bin
+*/
+//------------------------------------------------------------------------
+static inline unsigned int getBinIndex(double aPosition, unsigned int aNumberOfBins)
+//------------------------------------------------------------------------
+{
+    if (aPosition < 1.0)
+        return (0);
+    if (aPosition >= aNumberOfBins - 1)
+        return (aNumberOfBins - 1);
+
+    return (aPosition);
+}
+
+
+//------------------------------------------------------------------------
+/// Count the pixels of every grey level. Only 8-bit pixels are supported.
+/**
+* @param aView: the input pixels
+* @param aCounts: the number of pixels of each grey level
+* @return true if the levels have been counted, false otherwise
+*/
+//------------------------------------------------------------------------
+template <typename T>
+static bool getLevelCounts(const BasicImageView<T>&,
+                           std::vector<unsigned int>&)
+//------------------------------------------------------------------------
+{
+    return (false);
+}
+
+
+//------------------------------------------------------------------------
+static bool getLevelCounts(const BasicImageView<std::uint8_t>& aView,
+                           std::vector<unsigned int>& aCounts)
+//------------------------------------------------------------------------
+{
+    aCounts.assign(256, 0);
+    std::mutex mutex;
+
+    // Every band has its own counts, which are added at the end (the sum
+    // of integers does not depend on the order)
+    parallelForRows(aView.getHeight(), [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        std::vector<unsigned int> counts(256, 0);
+
+        for (unsigned int row(aFirstRow); row < aLastRow; row++) {
+            const std::uint8_t* p_data(aView.getRow(row));
+
+            for (unsigned int col(0); col < aView.getWidth(); col++)
+                counts[p_data[col]]++;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (unsigned int level(0); level < 256; level++)
+            aCounts[level] += counts[level];
+    });
+
+    return (true);
+}
+
+
+template <typename T>
+//------------------------------------
+BasicImageView<T>::BasicImageView():
+//------------------------------------
+        m_p_data(0),
+        m_width(0),
+        m_height(0),
+        m_stride(0)
+//------------------------------------
+{}
+
+
+template <typename T>
+//----------------------------------------------------
+BasicImageView<T>::BasicImageView(const T* apData,
+                                  unsigned int aWidth,
+                                  unsigned int aHeight,
+                                  unsigned int aStride):
+//----------------------------------------------------
+        m_p_data(apData),
+        m_width(aWidth),
+        m_height(aHeight),
+        m_stride(aStride)
+//----------------------------------------------------
+{}
+
+
+template <typename T>
+//--------------------------------------------------------------
+BasicImageView<T> BasicImageView<T>::getROI(unsigned int i,
+                                            unsigned int j,
+                                            unsigned int aWidth,
+                                            unsigned int aHeight) const
+//--------------------------------------------------------------
+{
+    // The ROI is outside the view
+    if (i >= m_width || j >= m_height)
+    {
+        return (BasicImageView());
+    }
+
+    // Clip the ROI to the view
+    return (BasicImageView(m_p_data + j * m_stride + i,
+            std::min(aWidth, m_width - i),
+            std::min(aHeight, m_height - j),
+            m_stride));
+}
+
+
+template <typename T>
+//------------------------------------------------------------
+T BasicImageView<T>::getPixel(unsigned int i, unsigned int j) const
+//------------------------------------------------------------
+{
+    // The pixel index is valid
+    if (i >= m_width || j >= m_height)
+    {
+        throw "Invalid pixel coordinate";
+    }
+
+    // Return the pixel value
+    return (m_p_data[j * m_stride + i]);
+}
+
+
+template <typename T>
+//-----------------------------------------------------
+const T* BasicImageView<T>::getRow(unsigned int j) const
+//-----------------------------------------------------
+{
+    return (m_p_data + j * m_stride);
+}
+
+
+template <typename T>
+//----------------------------------------------
+unsigned int BasicImageView<T>::getWidth() const
+//----------------------------------------------
+{
+    return (m_width);
+}
+
+
+template <typename T>
+//-----------------------------------------------
+unsigned int BasicImageView<T>::getHeight() const
+//-----------------------------------------------
+{
+    return (m_height);
+}
+
+
+template <typename T>
+//-----------------------------------------------
+unsigned int BasicImageView<T>::getStride() const
+//-----------------------------------------------
+{
+    return (m_stride);
+}
+
+
+template <typename T>
+//-----------------------------------------
+bool BasicImageView<T>::isEmpty() const
+//-----------------------------------------
+{
+    return (!m_p_data || !m_width || !m_height);
+}
+
+
+template <typename T>
+//---------------------------------------------------------
+ImageStatistics BasicImageView<T>::getStatistics() const
+//---------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    // Each row is processed while it is in the cache
+    std::vector<ImageStatistics> rowStatistics(m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for(unsigned int j(aFirstRow); j < aLastRow; j++)
+        {
+            const T* p_row(getRow(j));
+
+            T min_value(p_row[0]);
+            T max_value(p_row[0]);
+            double pixelSum = 0;
+            for(unsigned int i(0); i < m_width; i++)
+            {
+                min_value = std::min(min_value, p_row[i]);
+                max_value = std::max(max_value, p_row[i]);
+                pixelSum += p_row[i];
+            }
+
+            double avg = pixelSum / m_width;
+            double squares = 0;
+            for(unsigned int i(0); i < m_width; i++)
+                squares += (p_row[i] - avg) * (p_row[i] - avg);
+
+            ImageStatistics statistics = {m_width, double(min_value), double(max_value),
+                    pixelSum, avg, squares / m_width, 0.0};
+            rowStatistics[j] = statistics;
+        }
+    });
+
+    // The rows are merged in order, the result does not depend on the bands
+    ImageStatistics statistics = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    for(unsigned int j(0); j < m_height; j++)
+        statistics = mergeStatistics(statistics, rowStatistics[j]);
+
+    // A single row is not merged
+    statistics.standardDeviation = std::sqrt(statistics.variance);
+
+    return statistics;
+}
+
+
+template <typename T>
+//-------------------------------------------
+double BasicImageView<T>::getMinValue() const
+//-------------------------------------------
+{
+    // The image is empty
+    if (isEmpty())
+    {
+        throw "Empty image";
+    }
+
+    return (getStatistics().min);
+}
+
+
+template <typename T>
+//-------------------------------------------
+double BasicImageView<T>::getMaxValue() const
+//-------------------------------------------
+{
+    // The image is empty
+    if (isEmpty())
+    {
+        throw "Empty image";
+    }
+
+    return (getStatistics().max);
+}
+
+
+template <typename T>
+//--------------------------------------
+double BasicImageView<T>::getSum() const
+//--------------------------------------
+{
+    return getStatistics().sum;
+}
+
+
+template <typename T>
+//------------------------------------------
+double BasicImageView<T>::getAverage() const
+//------------------------------------------
+{
+    return getStatistics().mean;
+}
+
+
+template <typename T>
+//-------------------------------------------
+double BasicImageView<T>::getVariance() const
+//-------------------------------------------
+{
+    return getStatistics().variance;
+}
+
+
+template <typename T>
+//----------------------------------------------------
+double BasicImageView<T>::getStandardDeviation() const
+//----------------------------------------------------
+{
+    return getStatistics().standardDeviation;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------
+double BasicImageView<T>::computeSAE(const BasicImageView& aView) const
+//------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+    else if(aView.isEmpty())
+        throw "aImage Empty";
+
+    // The pixels cannot be paired
+    if(m_width != aView.m_width || m_height != aView.m_height)
+        throw "Image Sizes are different";
+
+    // Loop through each pixel of two images, one sum per row
+    std::vector<double> rowSum(m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; j++)
+        {
+            const T* p_row1(getRow(j));
+            const T* p_row2(aView.getRow(j));
+            double saeValue = 0.0;
+            for (unsigned int i(0); i < m_width; i++)
+                // Minus from each other, store absoutle value
+                saeValue += std::abs(double(p_row1[i]) - double(p_row2[i]));
+            rowSum[j] = saeValue;
+        }
+    });
+
+    // The rows are added in order, the result does not depend on the bands
+    double saeValue = 0.0;
+    for (unsigned int j(0); j < m_height; j++)
+        saeValue += rowSum[j];
+
+    return saeValue;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------
+double BasicImageView<T>::computeNCC(const BasicImageView& aView) const
+//------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+    else if(aView.isEmpty())
+        throw "aImage Empty";
+
+    // The pixels cannot be paired
+    if(m_width != aView.m_width || m_height != aView.m_height)
+        throw "Image Sizes are different";
+
+    // Mean and standard deviation for both images
+    ImageStatistics statistics1(getStatistics());
+    ImageStatistics statistics2(aView.getStatistics());
+    double avg1 = statistics1.mean;
+    double avg2 = statistics2.mean;
+    double stanDev1 = statistics1.standardDeviation;
+    double stanDev2 = statistics2.standardDeviation;
+
+    // Loop through each pixel of two images, one sum per row
+    std::vector<double> rowSum(m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; j++)
+        {
+            const T* p_row1(getRow(j));
+            const T* p_row2(aView.getRow(j));
+            double nccValue = 0.0;
+            for (unsigned int i(0); i < m_width; i++)
+                // Calcualting ncc value
+                nccValue += (p_row1[i] - avg1) * (p_row2[i] - avg2);
+            rowSum[j] = nccValue;
+        }
+    });
+
+    // The rows are added in order, the result does not depend on the bands
+    double nccValue = 0.0;
+    for (unsigned int j(0); j < m_height; j++)
+        nccValue += rowSum[j];
+
+    return nccValue / (stanDev1 * stanDev2) / (m_height * m_width);
+}
+
+
+template <typename T>
+//----------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::convolution(const double kernelArray[]) const
+//----------------------------------------------------------------------------
+{
+    return convolve<T>(kernelArray);
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::convolution(const Kernel& aKernel,
+                                             ConvolutionMethod aMethod,
+                                             BorderPolicy aBorder,
+                                             double aBorderValue) const
+//------------------------------------------------------------------------------------
+{
+    return convolve<T>(aKernel, aMethod, aBorder, aBorderValue);
+}
+
+
+template <typename T>
+template <typename U>
+//--------------------------------------------------------------------------
+BasicImage<U> BasicImageView<T>::convolve(const double kernelArray[]) const
+//--------------------------------------------------------------------------
+{
+    return convolve<U>(Kernel::fromArray3x3(kernelArray));
+}
+
+
+template <typename T>
+template <typename U>
+//----------------------------------------------------------------------------------
+BasicImage<U> BasicImageView<T>::convolve(const Kernel& aKernel,
+                                          ConvolutionMethod aMethod,
+                                          BorderPolicy aBorder,
+                                          double aBorderValue) const
+//----------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    // Centred 3x3 kernels on double precision pixels have a vectorised
+    // direct path, which is faster than the two passes of the separable path
+    bool vectorised(std::is_same<T, double>::value &&
+            aKernel.getWidth() == 3 && aKernel.getHeight() == 3 &&
+            aKernel.getAnchorX() == 1 && aKernel.getAnchorY() == 1 &&
+            m_width >= 3);
+
+    // The kernel is separable, use a row pass followed by a column pass
+    std::vector<double> horizontalKernel;
+    std::vector<double> verticalKernel;
+    bool separable(false);
+    if (aMethod == CONVOLUTION_SEPARABLE || (aMethod == CONVOLUTION_AUTOMATIC && !vectorised))
+        separable = aKernel.factorise(horizontalKernel, verticalKernel);
+
+    if (aMethod == CONVOLUTION_SEPARABLE && !separable)
+        throw "The kernel is not separable";
+
+    if (separable)
+        return (convolveSeparable<U>(horizontalKernel, verticalKernel,
+                aKernel.getAnchorX(), aKernel.getAnchorY(),
+                aBorder, aBorderValue));
+
+    // The cost of the direct loop grows with the area of the kernel, the
+    // cost of the transforms does not
+    if (aMethod == CONVOLUTION_FFT ||
+            (aMethod == CONVOLUTION_AUTOMATIC && aKernel.getWidth() * aKernel.getHeight() > 15 * 15))
+        return (convolveFFT<U>(aKernel, aBorder, aBorderValue));
+
+    int width(m_width);
+    int height(m_height);
+    int kernelWidth(aKernel.getWidth());
+    int kernelHeight(aKernel.getHeight());
+    int anchorCol(aKernel.getAnchorX());
+    int anchorRow(aKernel.getAnchorY());
+    const double* p_kernel(aKernel.getData());
+
+    // The interior is the area where the kernel is inside the image
+    int firstCol(std::min(anchorCol, width));
+    int lastCol(std::max(firstCol, width - (kernelWidth - 1 - anchorCol)));
+
+    BasicImage<U> tempImage(m_width, m_height);
+
+    // Move kernel through all pixels of the image, by bands of rows
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        std::vector<double> rowBuffer(vectorised ? m_width : 0);
+
+        for(int row(aFirstRow); row < int(aLastRow); row++) {
+            U* p_output(tempImage.getRowData(row));
+            bool rowInside(row >= anchorRow && row - anchorRow + kernelHeight <= height);
+
+            // The whole row is in the border
+            if (!rowInside) {
+                for(int col(0); col < width; col++)
+                    p_output[col] = PixelTraits<U>::fromDouble(
+                            convolveBorderPixel(row, col, aKernel, aBorder, aBorderValue));
+                continue;
+            }
+
+            // Left and right borders
+            for(int col(0); col < firstCol; col++)
+                p_output[col] = PixelTraits<U>::fromDouble(
+                        convolveBorderPixel(row, col, aKernel, aBorder, aBorderValue));
+            for(int col(lastCol); col < width; col++)
+                p_output[col] = PixelTraits<U>::fromDouble(
+                        convolveBorderPixel(row, col, aKernel, aBorder, aBorderValue));
+
+            // Compute the interior of the row at once
+            if (vectorised && convolveInterior3x3(*this, row, p_kernel, rowBuffer.data())) {
+                for(int col(firstCol); col < lastCol; col++)
+                    p_output[col] = PixelTraits<U>::fromDouble(rowBuffer[col]);
+                continue;
+            }
+
+            // Interior of the row, there is no need to check the indices
+            for(int col(firstCol); col < lastCol; col++) {
+                double pixelSum(0.0);
+
+                for(int kRow(0); kRow < kernelHeight; kRow++) {
+                    const T* p_data(getRow(row + kRow - anchorRow) + col - anchorCol);
+                    const double* p_coefficient(p_kernel + kRow * kernelWidth);
+
+                    // multiply pixel value with corresponding kernal value
+                    for(int kCol(0); kCol < kernelWidth; kCol++)
+                        pixelSum += p_coefficient[kCol] * p_data[kCol];
+                }
+
+                // Assign kernel value to pixel
+                p_output[col] = PixelTraits<U>::fromDouble(pixelSum);
+            }
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+template <typename U>
+//------------------------------------------------------------------------------
+BasicImage<U> BasicImageView<T>::convolveFFT(const Kernel& aKernel,
+                                             BorderPolicy aBorder,
+                                             double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    int width(m_width);
+    int height(m_height);
+    int kernelWidth(aKernel.getWidth());
+    int kernelHeight(aKernel.getHeight());
+    int anchorCol(aKernel.getAnchorX());
+    int anchorRow(aKernel.getAnchorY());
+
+    // The view extended by the pixels read by the kernel around it
+    unsigned int paddedWidth(m_width + kernelWidth - 1);
+    unsigned int paddedHeight(m_height + kernelHeight - 1);
+    std::vector<int> colIndex(paddedWidth);
+    for (unsigned int i(0); i < paddedWidth; ++i)
+        colIndex[i] = getBorderIndex(int(i) - anchorCol, width, aBorder);
+
+    BasicImage<double> padded(paddedWidth, paddedHeight);
+    parallelForRows(paddedHeight, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j) {
+            int row(getBorderIndex(int(j) - anchorRow, height, aBorder));
+            const T* p_input(row < 0 ? 0 : getRow(row));
+            double* p_output(padded.getRowData(j));
+
+            for (unsigned int i(0); i < paddedWidth; ++i)
+                p_output[i] = p_input && colIndex[i] >= 0 ?
+                        double(p_input[colIndex[i]]) : aBorderValue;
+        }
+    });
+
+    // The transforms are large enough for the kernel not to wrap around the
+    // extended view. The kernel is not flipped, hence the correlation.
+    unsigned int fftWidth(getFFTSize(paddedWidth));
+    unsigned int fftHeight(getFFTSize(paddedHeight));
+    Spectrum spectrum(padded.getView(), fftWidth, fftHeight);
+    spectrum.multiply(Spectrum(BasicImageView<double>(aKernel.getData(),
+                                                      kernelWidth,
+                                                      kernelHeight,
+                                                      kernelWidth),
+                               fftWidth, fftHeight),
+                      true);
+    BasicImage<double> correlation(spectrum.inverse());
+
+    BasicImage<U> tempImage(m_width, m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j) {
+            const double* p_input(correlation.getRow(j));
+            U* p_output(tempImage.getRowData(j));
+
+            for (unsigned int i(0); i < m_width; ++i)
+                p_output[i] = PixelTraits<U>::fromDouble(p_input[i]);
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+double BasicImageView<T>::convolveBorderPixel(int row,
+                                              int col,
+                                              const Kernel& aKernel,
+                                              BorderPolicy aBorder,
+                                              double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    int kernelWidth(aKernel.getWidth());
+    int kernelHeight(aKernel.getHeight());
+    const double* p_kernel(aKernel.getData());
+    double pixelSum(0.0);
+
+    for(int kRow(0); kRow < kernelHeight; kRow++) {
+        int tempRow(getBorderIndex(row + kRow - int(aKernel.getAnchorY()), m_height, aBorder));
+        const double* p_coefficient(p_kernel + kRow * kernelWidth);
+
+        for(int kCol(0); kCol < kernelWidth; kCol++) {
+            int tempCol(getBorderIndex(col + kCol - int(aKernel.getAnchorX()), m_width, aBorder));
+
+            // Pixels outside the image follow the border policy
+            if (tempRow < 0 || tempCol < 0)
+                pixelSum += p_coefficient[kCol] * aBorderValue;
+            else
+                pixelSum += p_coefficient[kCol] * getRow(tempRow)[tempCol];
+        }
+    }
+
+    return (pixelSum);
+}
+
+
+template <typename T>
+template <typename U>
+//--------------------------------------------------------------------------------------
+BasicImage<U> BasicImageView<T>::convolveSeparable(const std::vector<double>& aHorizontalKernel,
+                                                  const std::vector<double>& aVerticalKernel,
+                                                  int anchorCol,
+                                                  int anchorRow,
+                                                  BorderPolicy aBorder,
+                                                  double aBorderValue) const
+//--------------------------------------------------------------------------------------
+{
+    int width(m_width);
+    int height(m_height);
+    int kernelWidth(aHorizontalKernel.size());
+    int kernelHeight(aVerticalKernel.size());
+
+    // The interior is the area where the kernel is inside the image
+    int firstCol(std::min(anchorCol, width));
+    int lastCol(std::max(firstCol, width - (kernelWidth - 1 - anchorCol)));
+
+    // Row pass, in double precision
+    BasicImage<double> rowPass(m_width, m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for(int row(aFirstRow); row < int(aLastRow); row++) {
+            const T* p_input(getRow(row));
+            double* p_output(rowPass.getRowData(row));
+
+            // Interior of the row, there is no need to check the indices
+            for(int col(firstCol); col < lastCol; col++) {
+                const T* p_data(p_input + col - anchorCol);
+                double pixelSum(0.0);
+
+                for(int k(0); k < kernelWidth; k++)
+                    pixelSum += aHorizontalKernel[k] * p_data[k];
+
+                p_output[col] = pixelSum;
+            }
+
+            // Left and right borders
+            int borders[2][2] = {{0, firstCol}, {lastCol, width}};
+            for(int border(0); border < 2; border++)
+                for(int col(borders[border][0]); col < borders[border][1]; col++) {
+                    double pixelSum(0.0);
+
+                    // Pixels outside the image follow the border policy
+                    for(int k(0); k < kernelWidth; k++) {
+                        int tempCol(getBorderIndex(col + k - anchorCol, width, aBorder));
+                        pixelSum += aHorizontalKernel[k] * (tempCol < 0 ? aBorderValue : double(p_input[tempCol]));
+                    }
+
+                    p_output[col] = pixelSum;
+                }
+        }
+    });
+
+    // Rows outside the image have a constant value after the row pass
+    double rowBorderValue(0.0);
+    for(int k(0); k < kernelWidth; k++)
+        rowBorderValue += aHorizontalKernel[k] * aBorderValue;
+
+    // Column pass, a whole row is accumulated at once
+    BasicImage<U> tempImage(m_width, m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        std::vector<double> rowSum(m_width);
+        for(int row(aFirstRow); row < int(aLastRow); row++) {
+            std::fill(rowSum.begin(), rowSum.end(), 0.0);
+
+            for(int k(0); k < kernelHeight; k++) {
+                int tempRow(getBorderIndex(row + k - anchorRow, height, aBorder));
+                double kernelValue(aVerticalKernel[k]);
+
+                // The row follows the border policy
+                if (tempRow < 0) {
+                    for(int col(0); col < width; col++)
+                        rowSum[col] += kernelValue * rowBorderValue;
+                    continue;
+                }
+
+                const double* p_data(rowPass.getRow(tempRow));
+                for(int col(0); col < width; col++)
+                    rowSum[col] += kernelValue * p_data[col];
+            }
+
+            U* p_output(tempImage.getRowData(row));
+            for(int col(0); col < width; col++)
+                p_output[col] = PixelTraits<U>::fromDouble(rowSum[col]);
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::gradient(GradientOperator anOperator,
+                                          GradientMagnitude aMagnitude,
+                                          BasicImage<double>* apOrientation,
+                                          BorderPolicy aBorder,
+                                          double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    int width(m_width);
+    int paddedWidth(width + 2);
+    double weight(anOperator == GRADIENT_SOBEL ? 2.0 : 1.0);
+
+    // Copy the view with a one-pixel frame that follows the border policy
+    std::vector<T> padded;
+    copyWithBorder(*this, 1, aBorder, PixelTraits<T>::fromDouble(aBorderValue), padded);
+
+    BasicImage<T> tempImage(m_width, m_height);
+    if (apOrientation)
+        *apOrientation = BasicImage<double>(m_width, m_height);
+
+    // By bands of rows, every band has its own buffers
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        // Every column of 3 pixels, smoothed (for Gx) and differentiated (for Gy)
+        std::vector<double> smooth(paddedWidth);
+        std::vector<double> difference(paddedWidth);
+
+        for (int row(aFirstRow); row < int(aLastRow); row++) {
+            const T* p_above(&padded[row * paddedWidth]);
+            const T* p_centre(p_above + paddedWidth);
+            const T* p_below(p_centre + paddedWidth);
+
+            for (int col(0); col < paddedWidth; col++) {
+                smooth[col] = double(p_above[col]) + weight * p_centre[col] + p_below[col];
+                difference[col] = double(p_below[col]) - p_above[col];
+            }
+
+            T* p_output(tempImage.getRowData(row));
+            double* p_orientation(apOrientation ? apOrientation->getRowData(row) : 0);
+            for (int col(0); col < width; col++) {
+                double gx(smooth[col + 2] - smooth[col]);
+                double gy(difference[col] + weight * difference[col + 1] + difference[col + 2]);
+
+                if (aMagnitude == GRADIENT_L1)
+                    p_output[col] = PixelTraits<T>::fromDouble(std::abs(gx) + std::abs(gy));
+                else
+                    p_output[col] = PixelTraits<T>::fromDouble(std::sqrt(gx * gx + gy * gy));
+
+                if (p_orientation)
+                    p_orientation[col] = std::atan2(gy, gx);
+            }
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::sharpen(double anAmount,
+                                         unsigned int aRadius,
+                                         double aThreshold,
+                                         BorderPolicy aBorder,
+                                         double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    int width(m_width);
+    int height(m_height);
+    int radius(aRadius);
+    int diameter(2 * radius + 1);
+
+    // Binomial coefficients (row 2 * radius of Pascal's triangle), the
+    // normalisation is applied once to the 2D sum
+    std::vector<double> weights(diameter, 1.0);
+    for (int k(1); k < diameter; k++)
+        weights[k] = weights[k - 1] * (diameter - k) / k;
+    double normalisation(std::pow(0.25, 2 * radius));
+
+    BasicImage<T> tempImage(m_width, m_height);
+
+    // By bands of rows, every band has its own buffers
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        // Vertical sums of the current row, with a frame of radius pixels
+        std::vector<double> columnSum(width + 2 * radius);
+        std::vector<const T*> p_rows(diameter);
+
+        for (int row(aFirstRow); row < int(aLastRow); row++) {
+
+            // Rows of the window, null for the constant border
+            for (int kRow(0); kRow < diameter; kRow++) {
+                int tempRow(getBorderIndex(row + kRow - radius, height, aBorder));
+                p_rows[kRow] = tempRow < 0 ? 0 : getRow(tempRow);
+            }
+
+            // Vertical pass over the columns of the view
+            double* p_sum(&columnSum[radius]);
+            std::fill(p_sum, p_sum + width, 0.0);
+            for (int kRow(0); kRow < diameter; kRow++) {
+                const T* p_row(p_rows[kRow]);
+                double weight(weights[kRow]);
+
+                if (p_row) {
+                    for (int col(0); col < width; col++)
+                        p_sum[col] += weight * p_row[col];
+                }
+                else {
+                    for (int col(0); col < width; col++)
+                        p_sum[col] += weight * aBorderValue;
+                }
+            }
+
+            // The columns outside the view follow the border policy
+            // (the sum of a constant column is the constant times 4^radius)
+            for (int col(0); col < radius; col++) {
+                int leftCol(getBorderIndex(col - radius, width, aBorder));
+                int rightCol(getBorderIndex(width + col, width, aBorder));
+                double constantSum(aBorderValue * std::pow(2.0, 2 * radius));
+
+                columnSum[col] = leftCol < 0 ? constantSum : p_sum[leftCol];
+                columnSum[radius + width + col] = rightCol < 0 ? constantSum : p_sum[rightCol];
+            }
+
+            // Horizontal pass, then the unsharp mask
+            const T* p_data(getRow(row));
+            T* p_output(tempImage.getRowData(row));
+            for (int col(0); col < width; col++) {
+                double blur(0.0);
+                for (int kCol(0); kCol < diameter; kCol++)
+                    blur += weights[kCol] * columnSum[col + kCol];
+                blur *= normalisation;
+
+                double detail(p_data[col] - blur);
+
+                // Small details are considered as noise
+                if (std::abs(detail) < aThreshold)
+                    p_output[col] = p_data[col];
+                else
+                    p_output[col] = PixelTraits<T>::fromDouble(p_data[col] + anAmount * detail);
+            }
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::medianFilter(BorderPolicy aBorder, double aBorderValue) const
+//------------------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    int width(m_width);
+    int paddedWidth(width + 2);
+    T borderValue(PixelTraits<T>::fromDouble(aBorderValue));
+
+    // Copy the view with a one-pixel frame that follows the border policy
+    std::vector<T> padded;
+    copyWithBorder(*this, 1, aBorder, borderValue, padded);
+
+    BasicImage<T> tempImage(m_width, m_height);
+
+    // Move kernel through all pixels of the image, by bands of rows
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        // Every column of 3 pixels, sorted (shared by 3 neighbouring windows)
+        std::vector<T> low(paddedWidth);
+        std::vector<T> middle(paddedWidth);
+        std::vector<T> high(paddedWidth);
+
+        for (int row(aFirstRow); row < int(aLastRow); row++) {
+            const T* p_above(&padded[row * paddedWidth]);
+            const T* p_centre(p_above + paddedWidth);
+            const T* p_below(p_centre + paddedWidth);
+
+            // Sort the columns with 3 min/max exchanges, without any branch
+            for (int col(0); col < paddedWidth; col++) {
+                T lowest(std::min(p_above[col], p_centre[col]));
+                T highest(std::max(p_above[col], p_centre[col]));
+                T temp(std::max(lowest, p_below[col]));
+
+                low[col] = std::min(lowest, p_below[col]);
+                middle[col] = std::min(temp, highest);
+                high[col] = std::max(temp, highest);
+            }
+
+            // The median of the window is the median of the largest low value,
+            // the median of the middle values and the smallest high value
+            T* p_output(tempImage.getRowData(row));
+            for (int col(0); col < width; col++) {
+                T maxLow(std::max(std::max(low[col], low[col + 1]), low[col + 2]));
+                T minHigh(std::min(std::min(high[col], high[col + 1]), high[col + 2]));
+                T medianMiddle(median3(middle[col], middle[col + 1], middle[col + 2]));
+
+                // Assign window median to pixel
+                p_output[col] = median3(maxLow, medianMiddle, minHigh);
+            }
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::medianFilter(unsigned int aRadius,
+                                              BorderPolicy aBorder,
+                                              double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    // The window is a single pixel
+    if (!aRadius)
+        return (BasicImage<T>(*this));
+
+    // The sorting network is faster for the 3x3 window
+    if (aRadius == 1)
+        return (medianFilter(aBorder, aBorderValue));
+
+    // Copy the view with a frame that follows the border policy
+    std::vector<T> padded;
+    copyWithBorder(*this, aRadius, aBorder, PixelTraits<T>::fromDouble(aBorderValue), padded);
+
+    BasicImage<T> tempImage(m_width, m_height);
+
+    // Every band of rows has its own histograms
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        medianFilterWindow(padded, aRadius, aFirstRow, aLastRow, tempImage);
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::meanFilter(unsigned int aRadius,
+                                            BorderPolicy aBorder,
+                                            double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    // The windows of the border pixels are in the margin of the tables
+    IntegralImage integral(*this, aRadius, aBorder, aBorderValue, false);
+
+    int radius(aRadius);
+    double windowSize((2 * radius + 1) * (2 * radius + 1));
+    BasicImage<T> tempImage(m_width, m_height);
+
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (int j(aFirstRow); j < int(aLastRow); ++j)
+        {
+            T* p_output(tempImage.getRowData(j));
+
+            for (int i(0); i < int(m_width); ++i)
+            {
+                // The normalisation is done before rounding integer pixels
+                double sum(integral.getSum(i - radius, j - radius,
+                                           i + radius + 1, j + radius + 1));
+                p_output[i] = PixelTraits<T>::fromDouble(sum / windowSize);
+            }
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+void BasicImageView<T>::getLocalStatistics(unsigned int aRadius,
+                                           BasicImage<double>* apMean,
+                                           BasicImage<double>* apVariance,
+                                           BorderPolicy aBorder,
+                                           double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    IntegralImage integral(*this, aRadius, aBorder, aBorderValue, apVariance != 0);
+
+    int radius(aRadius);
+    double windowSize((2 * radius + 1) * (2 * radius + 1));
+
+    if (apMean)
+        *apMean = BasicImage<double>(m_width, m_height);
+    if (apVariance)
+        *apVariance = BasicImage<double>(m_width, m_height);
+
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (int j(aFirstRow); j < int(aLastRow); ++j)
+        {
+            double* p_mean(apMean ? apMean->getRowData(j) : 0);
+            double* p_variance(apVariance ? apVariance->getRowData(j) : 0);
+
+            for (int i(0); i < int(m_width); ++i)
+            {
+                int left(i - radius);
+                int top(j - radius);
+                int right(i + radius + 1);
+                int bottom(j + radius + 1);
+
+                double mean(integral.getSum(left, top, right, bottom) / windowSize);
+
+                if (p_mean)
+                    p_mean[i] = mean;
+
+                // E[x^2] - E[x]^2, the rounding errors may make it negative
+                if (p_variance)
+                    p_variance[i] = std::max(0.0,
+                            integral.getSquaredSum(left, top, right, bottom) / windowSize -
+                            mean * mean);
+            }
+        }
+    });
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+BasicImage<T> BasicImageView<T>::gaussianFilter(double aSigma,
+                                                BorderPolicy aBorder,
+                                                double aBorderValue) const
+//------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    // The recursive filter is a poor fit of narrow gaussians, whose sampled
+    // kernel is short anyway (at most 19 taps per pass)
+    if (aSigma < 3.0)
+        return (convolution(Kernel::gaussian(aSigma), CONVOLUTION_AUTOMATIC, aBorder, aBorderValue));
+
+    RecursiveGaussian recursiveGaussian(aSigma);
+
+    // The clamp and constant borders are constant after the edges; the other
+    // borders are read in a margin, then clamped
+    unsigned int margin(0);
+    if (aBorder == BORDER_REFLECT || aBorder == BORDER_WRAP)
+        margin = std::ceil(4.0 * aSigma);
+
+    int width(m_width);
+    int height(m_height);
+    unsigned int paddedWidth(m_width + 2 * margin);
+    unsigned int paddedHeight(m_height + 2 * margin);
+
+    // Column and row of the view read by each position of the margin
+    std::vector<int> colIndex(paddedWidth);
+    for (unsigned int i(0); i < paddedWidth; ++i)
+        colIndex[i] = getBorderIndex(int(i) - int(margin), width, aBorder);
+
+    std::vector<int> rowIndex(paddedHeight);
+    for (unsigned int j(0); j < paddedHeight; ++j)
+        rowIndex[j] = getBorderIndex(int(j) - int(margin), height, aBorder);
+
+    // Row pass, the rows are independent
+    std::vector<double> rowFiltered(m_width * m_height);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        std::vector<double> signal(paddedWidth);
+
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            const T* p_row(getRow(j));
+            for (unsigned int i(0); i < paddedWidth; ++i)
+                signal[i] = colIndex[i] < 0 ? aBorderValue : double(p_row[colIndex[i]]);
+
+            double before(aBorder == BORDER_CONSTANT ? aBorderValue : signal[0]);
+            double after(aBorder == BORDER_CONSTANT ? aBorderValue : signal[paddedWidth - 1]);
+            recursiveGaussian.filter(&signal[0], paddedWidth, 1, &before, &after);
+
+            std::copy(signal.begin() + margin, signal.begin() + margin + m_width,
+                      rowFiltered.begin() + j * m_width);
+        }
+    });
+
+    // Column pass on blocks of columns, so that whole rows of the block are read
+    const unsigned int blockWidth(64);
+    BasicImage<T> tempImage(m_width, m_height);
+    ThreadPool::getInstance().parallelFor(0, m_width, [&](unsigned int aFirstCol, unsigned int aLastCol) {
+        std::vector<double> signal(paddedHeight * blockWidth);
+        std::vector<double> before(blockWidth);
+        std::vector<double> after(blockWidth);
+
+        for (unsigned int first(aFirstCol); first < aLastCol; first += blockWidth)
+        {
+            unsigned int lanes(std::min(blockWidth, aLastCol - first));
+
+            for (unsigned int j(0); j < paddedHeight; ++j)
+            {
+                double* p_signal(&signal[j * lanes]);
+                if (rowIndex[j] < 0)
+                    std::fill(p_signal, p_signal + lanes, aBorderValue);
+                else
+                    std::copy(rowFiltered.begin() + rowIndex[j] * m_width + first,
+                              rowFiltered.begin() + rowIndex[j] * m_width + first + lanes,
+                              p_signal);
+            }
+
+            for (unsigned int l(0); l < lanes; ++l)
+            {
+                before[l] = aBorder == BORDER_CONSTANT ? aBorderValue : signal[l];
+                after[l] = aBorder == BORDER_CONSTANT ? aBorderValue : signal[(paddedHeight - 1) * lanes + l];
+            }
+            recursiveGaussian.filter(&signal[0], paddedHeight, lanes, &before[0], &after[0]);
+
+            for (unsigned int j(0); j < m_height; ++j)
+            {
+                T* p_output(tempImage.getRowData(j) + first);
+                const double* p_signal(&signal[(j + margin) * lanes]);
+
+                for (unsigned int l(0); l < lanes; ++l)
+                    p_output[l] = PixelTraits<T>::fromDouble(p_signal[l]);
+            }
+        }
+    });
+
+    return tempImage;
+}
+
+
+template <typename T>
+//---------------------------------------------------------------------------------------
+std::vector<unsigned int> BasicImageView<T>::getHistogram(unsigned int aNumberOfBins) const
+//---------------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    ImageStatistics statistics(getStatistics());
+    return getHistogram(aNumberOfBins, statistics.min, statistics.max);
+}
+
+
+template <typename T>
+//---------------------------------------------------------------------------------------
+std::vector<unsigned int> BasicImageView<T>::getHistogram(unsigned int aNumberOfBins,
+                                                          double aMinValue,
+                                                          double aMaxValue) const
+//---------------------------------------------------------------------------------------
+{
+    // If image is empty
+    if(isEmpty())
+        throw "Image Empty";
+
+    std::vector<unsigned int> p_histogram_data(aNumberOfBins, 0);
+
+    // No bin
+    if (!aNumberOfBins)
+        return p_histogram_data;
+
+    double binMax = aMaxValue;
+    double binMin = aMinValue;
+    double range = binMax - binMin;
+
+    // Every pixel has the same value, it is the maximum (last bin)
+    if (range <= 0.0) {
+        p_histogram_data[aNumberOfBins - 1] = m_width * m_height;
+        return p_histogram_data;
+    }
+
+    double scale = aNumberOfBins / range;
+
+    // 8-bit data: count the grey levels, then put each level in its bin
+    std::vector<unsigned int> levelCounts;
+    if (getLevelCounts(*this, levelCounts)) {
+        for (unsigned int level = 0; level < levelCounts.size(); level++) {
+            if (levelCounts[level]) {
+                double position((level - binMin) * scale);
+                p_histogram_data[getBinIndex(position, aNumberOfBins)] += levelCounts[level];
+            }
+        }
+
+        return p_histogram_data;
+    }
+
+    std::mutex mutex;
+
+    // Every band has its own histogram, which are added at the end
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        std::vector<unsigned int> histogram(aNumberOfBins, 0);
+
+        for(unsigned int row = aFirstRow; row < aLastRow; row++) {
+            const T* p_data(getRow(row));
+
+            for(unsigned int col = 0; col < m_width; col++) {
+
+                // The maximum is in the last bin
+                double position((p_data[col] - binMin) * scale);
+                histogram[getBinIndex(position, aNumberOfBins)]++;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for(unsigned int bin = 0; bin < aNumberOfBins; bin++)
+            p_histogram_data[bin] += histogram[bin];
+    });
+
+    return p_histogram_data;
+}
+
+
+//******************************************************************************
+//  Explicit instantiations
+//******************************************************************************
+template class BasicImageView<std::uint8_t>;
+template class BasicImageView<std::uint16_t>;
+template class BasicImageView<float>;
+template class BasicImageView<double>;
+
+// Convolutions
+template BasicImage<std::uint8_t> BasicImageView<std::uint8_t>::convolve<std::uint8_t>(const double[]) const;
+template BasicImage<std::uint16_t> BasicImageView<std::uint16_t>::convolve<std::uint16_t>(const double[]) const;
+template BasicImage<float> BasicImageView<float>::convolve<float>(const double[]) const;
+template BasicImage<double> BasicImageView<double>::convolve<double>(const double[]) const;
+template BasicImage<std::uint8_t> BasicImageView<std::uint8_t>::convolve<std::uint8_t>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
+template BasicImage<std::uint16_t> BasicImageView<std::uint16_t>::convolve<std::uint16_t>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
+template BasicImage<float> BasicImageView<float>::convolve<float>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
+template BasicImage<double> BasicImageView<double>::convolve<double>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
+
+// Convolutions with a double precision result
+template BasicImage<double> BasicImageView<std::uint8_t>::convolve<double>(const double[]) const;
+template BasicImage<double> BasicImageView<std::uint16_t>::convolve<double>(const double[]) const;
+template BasicImage<double> BasicImageView<float>::convolve<double>(const double[]) const;
+template BasicImage<double> BasicImageView<std::uint8_t>::convolve<double>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
+template BasicImage<double> BasicImageView<std::uint16_t>::convolve<double>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
+template BasicImage<double> BasicImageView<float>::convolve<double>(const Kernel&, ConvolutionMethod, BorderPolicy, double) const;
@@ -0,0 +1,204 @@
+/**
+********************************************************************************
+*
+*   @file       IntegralImage.cpp
+*
+*   @brief      Summed-area tables of an image, to compute the sum of the
+*               pixels of any rectangle in constant time.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h> // Header file for SSE2 intrinsics
+#define INTEGRAL_IMAGE_HAS_SSE2
+#endif
+
+#include <cstdint>
+
+#include "IntegralImage.h"
+#include "ImageView.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Add a row of a table to the next one, over a range of columns.
+/// The additions are the same with or without SSE2, so the tables do not
+/// depend on the instruction set.
+/**
+* @param apPrevious: the previous row
+* @param apRow: the row, which receives the sums
+* @param aFirst: the first column
+* @param aLast: the column after the last column
+*/
+//------------------------------------------------------------------------
+static void accumulateRow(const double* apPrevious,
+                          double* apRow,
+                          unsigned int aFirst,
+                          unsigned int aLast)
+//------------------------------------------------------------------------
+{
+    unsigned int i(aFirst);
+
+#ifdef INTEGRAL_IMAGE_HAS_SSE2
+    // 2 columns at a time
+    for (; i + 2 <= aLast; i += 2)
+    {
+        _mm_storeu_pd(apRow + i, _mm_add_pd(_mm_loadu_pd(apRow + i),
+                                            _mm_loadu_pd(apPrevious + i)));
+    }
+#endif
+
+    for (; i < aLast; ++i)
+    {
+        apRow[i] += apPrevious[i];
+    }
+}
+
+
+//-------------------------------
+IntegralImage::IntegralImage():
+//-------------------------------
+        m_width(0),
+        m_height(0),
+        m_margin(0),
+        m_stride(0)
+//-------------------------------
+{}
+
+
+template <typename T>
+//--------------------------------------------------------------------
+IntegralImage::IntegralImage(const BasicImageView<T>& aView,
+                             unsigned int aMargin,
+                             BorderPolicy aBorder,
+                             double aBorderValue,
+                             bool aSquaredSums):
+//--------------------------------------------------------------------
+        m_width(aView.getWidth()),
+        m_height(aView.getHeight()),
+        m_margin(aMargin),
+        m_stride(aView.getWidth() + 2 * aMargin + 1)
+//--------------------------------------------------------------------
+{
+    // If image is empty
+    if (aView.isEmpty())
+        throw "Image Empty";
+
+    int margin(m_margin);
+    int width(m_width);
+    int height(m_height);
+    unsigned int paddedWidth(m_width + 2 * m_margin);
+    unsigned int paddedHeight(m_height + 2 * m_margin);
+
+    // The first row and the first column are zeros
+    m_sum_table.assign(m_stride * (paddedHeight + 1), 0.0);
+    if (aSquaredSums)
+    {
+        m_squared_sum_table.assign(m_stride * (paddedHeight + 1), 0.0);
+    }
+
+    // Column of the view read by each column of the margin
+    std::vector<int> colIndex(paddedWidth);
+    for (unsigned int i(0); i < paddedWidth; ++i)
+    {
+        colIndex[i] = getBorderIndex(int(i) - margin, width, aBorder);
+    }
+
+    // Prefix sums along each row, the rows are independent
+    parallelForRows(paddedHeight, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            int row(getBorderIndex(int(j) - margin, height, aBorder));
+            const T* p_input(row < 0 ? 0 : aView.getRow(row));
+
+            double* p_sum(&m_sum_table[0] + (j + 1) * m_stride);
+            double* p_squared_sum(aSquaredSums ?
+                    &m_squared_sum_table[0] + (j + 1) * m_stride : 0);
+
+            double sum(0.0);
+            double squared_sum(0.0);
+            for (unsigned int i(0); i < paddedWidth; ++i)
+            {
+                double value(p_input && colIndex[i] >= 0 ?
+                        double(p_input[colIndex[i]]) : aBorderValue);
+
+                sum += value;
+                p_sum[i + 1] = sum;
+
+                if (p_squared_sum)
+                {
+                    squared_sum += value * value;
+                    p_squared_sum[i + 1] = squared_sum;
+                }
+            }
+        }
+    });
+
+    // Accumulate the rows downwards, the columns are independent
+    ThreadPool::getInstance().parallelFor(0, m_stride, [&](unsigned int aFirstCol, unsigned int aLastCol) {
+        for (unsigned int j(1); j < paddedHeight; ++j)
+        {
+            accumulateRow(&m_sum_table[0] + j * m_stride,
+                          &m_sum_table[0] + (j + 1) * m_stride,
+                          aFirstCol, aLastCol);
+
+            if (aSquaredSums)
+            {
+                accumulateRow(&m_squared_sum_table[0] + j * m_stride,
+                              &m_squared_sum_table[0] + (j + 1) * m_stride,
+                              aFirstCol, aLastCol);
+            }
+        }
+    });
+}
+
+
+//--------------------------------------------
+unsigned int IntegralImage::getWidth() const
+//--------------------------------------------
+{
+    return (m_width);
+}
+
+
+//---------------------------------------------
+unsigned int IntegralImage::getHeight() const
+//---------------------------------------------
+{
+    return (m_height);
+}
+
+
+//---------------------------------------------
+unsigned int IntegralImage::getMargin() const
+//---------------------------------------------
+{
+    return (m_margin);
+}
+
+
+//******************************************************************************
+//  Explicit instantiations
+//******************************************************************************
+template IntegralImage::IntegralImage(const BasicImageView<std::uint8_t>&, unsigned int, BorderPolicy, double, bool);
+template IntegralImage::IntegralImage(const BasicImageView<std::uint16_t>&, unsigned int, BorderPolicy, double, bool);
+template IntegralImage::IntegralImage(const BasicImageView<float>&, unsigned int, BorderPolicy, double, bool);
+template IntegralImage::IntegralImage(const BasicImageView<double>&, unsigned int, BorderPolicy, double, bool);
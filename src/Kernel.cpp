@@ -0,0 +1,249 @@
+/**
+********************************************************************************
+*
+*   @file       Kernel.cpp
+*
+*   @brief      Class to store a convolution kernel of any size.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <cmath> // Header file for abs/exp/ceil
+
+#include "Kernel.h"
+
+
+//--------------------------------------------------------
+Kernel::Kernel(unsigned int aWidth, unsigned int aHeight):
+//--------------------------------------------------------
+        m_width(aWidth),
+        m_height(aHeight),
+        m_anchor_x(aWidth / 2),
+        m_anchor_y(aHeight / 2),
+        m_p_data(aWidth * aHeight, 0.0)
+//--------------------------------------------------------
+{
+    // The kernel is empty
+    if (!m_width || !m_height)
+    {
+        throw "Invalid kernel size";
+    }
+}
+
+
+//---------------------------------------------------------------------------
+Kernel::Kernel(const double* apData, unsigned int aWidth, unsigned int aHeight):
+//---------------------------------------------------------------------------
+        m_width(aWidth),
+        m_height(aHeight),
+        m_anchor_x(aWidth / 2),
+        m_anchor_y(aHeight / 2),
+        m_p_data(apData, apData + aWidth * aHeight)
+//---------------------------------------------------------------------------
+{
+    // The kernel is empty
+    if (!m_width || !m_height)
+    {
+        throw "Invalid kernel size";
+    }
+}
+
+
+//-------------------------------------------------------
+Kernel Kernel::fromArray3x3(const double kernelArray[])
+//-------------------------------------------------------
+{
+    Kernel kernel(3, 3);
+
+    // The array is stored column by column
+    for (unsigned int j(0); j < 3; ++j)
+        for (unsigned int i(0); i < 3; ++i)
+            kernel.m_p_data[j * 3 + i] = kernelArray[i * 3 + j];
+
+    return (kernel);
+}
+
+
+//------------------------------------------
+Kernel Kernel::gaussian(double aSigma)
+//------------------------------------------
+{
+    // Invalid standard deviation
+    if (aSigma <= 0.0)
+    {
+        throw "Invalid standard deviation";
+    }
+
+    // The radius covers 3 standard deviations
+    int radius(std::ceil(3.0 * aSigma));
+    Kernel kernel(2 * radius + 1, 2 * radius + 1);
+
+    // Compute the 1D profile
+    std::vector<double> profile(2 * radius + 1);
+    double sum(0.0);
+    for (int k(-radius); k <= radius; ++k)
+    {
+        profile[k + radius] = std::exp(-0.5 * k * k / (aSigma * aSigma));
+        sum += profile[k + radius];
+    }
+
+    // The 2D kernel is the product of the normalised profiles
+    for (unsigned int j(0); j < kernel.m_height; ++j)
+        for (unsigned int i(0); i < kernel.m_width; ++i)
+            kernel.m_p_data[j * kernel.m_width + i] = profile[j] * profile[i] / (sum * sum);
+
+    return (kernel);
+}
+
+
+//------------------------------------------------------------
+Kernel Kernel::mean(unsigned int aWidth, unsigned int aHeight)
+//------------------------------------------------------------
+{
+    Kernel kernel(aWidth, aHeight);
+
+    // Every coefficient has the same weight
+    kernel.m_p_data.assign(aWidth * aHeight, 1.0 / (aWidth * aHeight));
+
+    return (kernel);
+}
+
+
+//----------------------------------
+unsigned int Kernel::getWidth() const
+//----------------------------------
+{
+    return (m_width);
+}
+
+
+//-----------------------------------
+unsigned int Kernel::getHeight() const
+//-----------------------------------
+{
+    return (m_height);
+}
+
+
+//------------------------------------
+unsigned int Kernel::getAnchorX() const
+//------------------------------------
+{
+    return (m_anchor_x);
+}
+
+
+//------------------------------------
+unsigned int Kernel::getAnchorY() const
+//------------------------------------
+{
+    return (m_anchor_y);
+}
+
+
+//-------------------------------------------------
+void Kernel::setAnchor(unsigned int i, unsigned int j)
+//-------------------------------------------------
+{
+    // The anchor is outside the kernel
+    if (i >= m_width || j >= m_height)
+    {
+        throw "Invalid anchor";
+    }
+
+    m_anchor_x = i;
+    m_anchor_y = j;
+}
+
+
+//----------------------------------------------------------------
+void Kernel::setValue(unsigned int i, unsigned int j, double aValue)
+//----------------------------------------------------------------
+{
+    // The coefficient is outside the kernel
+    if (i >= m_width || j >= m_height)
+    {
+        throw "Invalid kernel coordinate";
+    }
+
+    m_p_data[j * m_width + i] = aValue;
+}
+
+
+//------------------------------------------------------------
+double Kernel::getValue(unsigned int i, unsigned int j) const
+//------------------------------------------------------------
+{
+    // The coefficient is outside the kernel
+    if (i >= m_width || j >= m_height)
+    {
+        throw "Invalid kernel coordinate";
+    }
+
+    return (m_p_data[j * m_width + i]);
+}
+
+
+//-----------------------------------
+const double* Kernel::getData() const
+//-----------------------------------
+{
+    return (m_p_data.data());
+}
+
+
+//-----------------------------------------------------------------
+bool Kernel::factorise(std::vector<double>& aHorizontalKernel,
+                       std::vector<double>& aVerticalKernel) const
+//-----------------------------------------------------------------
+{
+    // Find the largest coefficient, it is used as pivot
+    unsigned int pivot_row(0);
+    unsigned int pivot_col(0);
+    double max_value(0.0);
+    for (unsigned int y(0); y < m_height; ++y)
+        for (unsigned int x(0); x < m_width; ++x)
+            if (std::abs(m_p_data[y * m_width + x]) > max_value)
+            {
+                max_value = std::abs(m_p_data[y * m_width + x]);
+                pivot_row = y;
+                pivot_col = x;
+            }
+
+    // The kernel is null
+    if (max_value == 0.0)
+        return (false);
+
+    double pivot(m_p_data[pivot_row * m_width + pivot_col]);
+
+    // The column of the pivot gives the vertical kernel,
+    // its row (normalised by the pivot) gives the horizontal kernel
+    aVerticalKernel.resize(m_height);
+    aHorizontalKernel.resize(m_width);
+    for (unsigned int y(0); y < m_height; ++y)
+        aVerticalKernel[y] = m_p_data[y * m_width + pivot_col];
+    for (unsigned int x(0); x < m_width; ++x)
+        aHorizontalKernel[x] = m_p_data[pivot_row * m_width + x] / pivot;
+
+    // Every coefficient must be the product of the two vectors
+    for (unsigned int y(0); y < m_height; ++y)
+        for (unsigned int x(0); x < m_width; ++x)
+            if (std::abs(aVerticalKernel[y] * aHorizontalKernel[x] -
+                    m_p_data[y * m_width + x]) > 1.0e-12 * max_value)
+                return (false);
+
+    return (true);
+}
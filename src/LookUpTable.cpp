@@ -0,0 +1,352 @@
+/**
+********************************************************************************
+*
+*   @file       LookUpTable.cpp
+*
+*   @brief      Table of the values of a point operation for every pixel
+*               value of an integer image.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Define
+//******************************************************************************
+// The AVX2 gathers are compiled in a function specific target, then detected
+// at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LOOK_UP_TABLE_HAS_SIMD
+#endif
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#ifdef LOOK_UP_TABLE_HAS_SIMD
+#include <immintrin.h> // Header file for AVX2 intrinsics
+#endif
+
+#include <cmath> // Header file for abs
+#include <cstdint>
+#include <limits>
+
+#include "LookUpTable.h"
+
+
+/// Signature of the implementations
+template <typename T>
+struct LookUpFunction
+{
+    typedef void (*Type)(const T*, const T*, T*, unsigned int);
+};
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Map the pixels from aStart to aCount, four at a time.
+//------------------------------------------------------------------------
+template <typename T>
+static void lookUpScalar(const T* apTable,
+                         const T* apInput,
+                         T* apOutput,
+                         unsigned int aStart,
+                         unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    unsigned int i(aStart);
+
+    // The lookups are independent, 4 of them are in flight at once
+    for (; i + 4 <= aCount; i += 4)
+    {
+        T value0(apTable[apInput[i]]);
+        T value1(apTable[apInput[i + 1]]);
+        T value2(apTable[apInput[i + 2]]);
+        T value3(apTable[apInput[i + 3]]);
+
+        apOutput[i] = value0;
+        apOutput[i + 1] = value1;
+        apOutput[i + 2] = value2;
+        apOutput[i + 3] = value3;
+    }
+
+    for (; i < aCount; ++i)
+    {
+        apOutput[i] = apTable[apInput[i]];
+    }
+}
+
+
+//------------------------------------------------------------------------
+/// Plain C++ implementation.
+//------------------------------------------------------------------------
+template <typename T>
+static void lookUpGeneric(const T* apTable,
+                          const T* apInput,
+                          T* apOutput,
+                          unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    lookUpScalar(apTable, apInput, apOutput, 0, aCount);
+}
+
+
+#ifdef LOOK_UP_TABLE_HAS_SIMD
+//------------------------------------------------------------------------
+/// Gather the entries of 8 pixels of 16 bits. The gather reads 32 bits per
+/// pixel, the high half, which belongs to the next entry, is cleared.
+//------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static inline __m256i gatherEntries(const int* apTable, const std::uint16_t* apInput)
+//------------------------------------------------------------------------
+{
+    __m256i index(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(apInput))));
+    return (_mm256_and_si256(_mm256_i32gather_epi32(apTable, index, 2), _mm256_set1_epi32(0xFFFF)));
+}
+
+
+//------------------------------------------------------------------------
+/// Pack the entries of 16 pixels, gathered by two registers, into 16 bits.
+//------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static inline __m256i packEntries(__m256i aFirst, __m256i aSecond)
+//------------------------------------------------------------------------
+{
+    // The pack works within each 128-bit lane, the permutation puts the
+    // pixels back in order
+    return (_mm256_permute4x64_epi64(_mm256_packus_epi32(aFirst, aSecond), 0xD8));
+}
+
+
+//------------------------------------------------------------------------
+/// AVX2 implementation for 16-bit pixels, 32 pixels at a time (four
+/// independent gathers of 8 pixels).
+//------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static void lookUpAVX2(const std::uint16_t* apTable,
+                       const std::uint16_t* apInput,
+                       std::uint16_t* apOutput,
+                       unsigned int aCount)
+//------------------------------------------------------------------------
+{
+    const int* p_table(reinterpret_cast<const int*>(apTable));
+
+    unsigned int i(0);
+    for (; i + 32 <= aCount; i += 32)
+    {
+        __m256i value_0(gatherEntries(p_table, apInput + i));
+        __m256i value_1(gatherEntries(p_table, apInput + i + 8));
+        __m256i value_2(gatherEntries(p_table, apInput + i + 16));
+        __m256i value_3(gatherEntries(p_table, apInput + i + 24));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(apOutput + i), packEntries(value_0, value_1));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(apOutput + i + 16), packEntries(value_2, value_3));
+    }
+
+    // Remaining pixels
+    lookUpScalar(apTable, apInput, apOutput, i, aCount);
+}
+#endif
+
+
+//------------------------------------------------------------------------
+/// Select the best implementation supported by the CPU.
+//------------------------------------------------------------------------
+static LookUpFunction<std::uint8_t>::Type selectLookUp(const std::uint8_t*)
+//------------------------------------------------------------------------
+{
+    // A 256-entry table stays in L1, the scalar loop is as fast as the
+    // byte shuffles
+    return (lookUpGeneric<std::uint8_t>);
+}
+
+
+static LookUpFunction<std::uint16_t>::Type selectLookUp(const std::uint16_t*)
+//------------------------------------------------------------------------
+{
+#ifdef LOOK_UP_TABLE_HAS_SIMD
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return (lookUpAVX2);
+    }
+#endif
+
+    return (lookUpGeneric<std::uint16_t>);
+}
+
+
+//------------------------------------------------------------------------
+/// Accessor on the selected implementation, which is selected only once.
+//------------------------------------------------------------------------
+template <typename T>
+static typename LookUpFunction<T>::Type getLookUpFunction(const T* apTable)
+//------------------------------------------------------------------------
+{
+    static const typename LookUpFunction<T>::Type p_function(selectLookUp(apTable));
+    return (p_function);
+}
+
+
+
+template <typename T>
+//-------------------------------------
+LookUpTable<T>::LookUpTable():
+//-------------------------------------
+        m_entry_set(std::size_t(std::numeric_limits<T>::max()) + 2, T(0))
+//-------------------------------------
+{
+    for (unsigned int i(0); i < getSize(); ++i)
+    {
+        m_entry_set[i] = T(i);
+    }
+}
+
+
+template <typename T>
+//-------------------------------------------------
+unsigned int LookUpTable<T>::getSize() const
+//-------------------------------------------------
+{
+    return (std::size_t(std::numeric_limits<T>::max()) + 1);
+}
+
+
+template <typename T>
+//-------------------------------------------
+const T* LookUpTable<T>::getData() const
+//-------------------------------------------
+{
+    return (&m_entry_set[0]);
+}
+
+
+template <typename T>
+//-----------------------------------------------------------
+T LookUpTable<T>::operator[](unsigned int aValue) const
+//-----------------------------------------------------------
+{
+    return (m_entry_set[aValue]);
+}
+
+
+template <typename T>
+//-------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::add(double aValue)
+//-------------------------------------------------------
+{
+    return (append([aValue](double aPixel) { return (aPixel + aValue); }));
+}
+
+
+template <typename T>
+//------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::subtract(double aValue)
+//------------------------------------------------------------
+{
+    return (append([aValue](double aPixel) { return (aPixel - aValue); }));
+}
+
+
+template <typename T>
+//------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::multiply(double aValue)
+//------------------------------------------------------------
+{
+    return (append([aValue](double aPixel) { return (aPixel * aValue); }));
+}
+
+
+template <typename T>
+//----------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::divide(double aValue)
+//----------------------------------------------------------
+{
+    // Division by zero
+    if (std::abs(aValue) < 1.0e-6)
+    {
+        throw "Division by zero.";
+    }
+
+    return (append([aValue](double aPixel) { return (aPixel / aValue); }));
+}
+
+
+template <typename T>
+//-------------------------------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::shiftScale(double aShiftValue, double aScaleValue)
+//-------------------------------------------------------------------------------------
+{
+    return (append([aShiftValue, aScaleValue](double aPixel) {
+        return ((aPixel + aShiftValue) * aScaleValue);
+    }));
+}
+
+
+template <typename T>
+//---------------------------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::normalise(double aMinValue, double aMaxValue)
+//---------------------------------------------------------------------------------
+{
+    return (shiftScale(-aMinValue, 1.0 / (aMaxValue - aMinValue)));
+}
+
+
+template <typename T>
+//------------------------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::negate(double aMinValue, double aMaxValue)
+//------------------------------------------------------------------------------
+{
+    return (append([aMinValue, aMaxValue](double aPixel) {
+        // Take care to preserve the dynamic of the image
+        double range(aMaxValue - aMinValue);
+        return (aMinValue + range * (1.0 - (aPixel - aMinValue) / range));
+    }));
+}
+
+
+template <typename T>
+//----------------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::threshold(double aThresholdValue)
+//----------------------------------------------------------------------
+{
+    return (append([aThresholdValue](double aPixel) {
+        return (aPixel > aThresholdValue ? 1.0 : 0.0);
+    }));
+}
+
+
+template <typename T>
+//-------------------------------------------------------------------
+LookUpTable<T>& LookUpTable<T>::append(const LookUpTable& aTable)
+//-------------------------------------------------------------------
+{
+    aTable.apply(&m_entry_set[0], &m_entry_set[0], getSize());
+    return (*this);
+}
+
+
+template <typename T>
+//----------------------------------------------------------------------------------------
+void LookUpTable<T>::apply(const T* apInput, T* apOutput, unsigned int aLength) const
+//----------------------------------------------------------------------------------------
+{
+    getLookUpFunction(&m_entry_set[0])(&m_entry_set[0], apInput, apOutput, aLength);
+}
+
+
+//******************************************************************************
+//  Explicit instantiations
+//******************************************************************************
+template class LookUpTable<std::uint8_t>;
+template class LookUpTable<std::uint16_t>;
@@ -0,0 +1,176 @@
+/**
+********************************************************************************
+*
+*   @file       RecursiveGaussian.cpp
+*
+*   @brief      Recursive (IIR) approximation of the Gaussian filter, whose
+*               cost per sample does not depend on the standard deviation.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <algorithm> // Header file for copy
+#include <cmath> // Header file for sqrt/abs
+#include <vector>
+
+#include "RecursiveGaussian.h"
+
+
+//---------------------------------------------------------
+RecursiveGaussian::RecursiveGaussian(double aSigma)
+//---------------------------------------------------------
+{
+    // Invalid standard deviation
+    if (aSigma < getMinimumSigma())
+    {
+        throw "The standard deviation is too small for the recursive gaussian";
+    }
+
+    // Young and van Vliet, "Recursive implementation of the Gaussian filter",
+    // Signal Processing 44 (1995)
+    double q(aSigma >= 2.5 ?
+            0.98711 * aSigma - 0.96330 :
+            3.97156 - 4.14554 * std::sqrt(1.0 - 0.26891 * aSigma));
+
+    double q2(q * q);
+    double q3(q2 * q);
+    double b0(1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3);
+
+    m_a[0] = (2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+    m_a[1] = -(1.4281 * q2 + 1.26661 * q3) / b0;
+    m_a[2] = 0.422205 * q3 / b0;
+    m_b = 1.0 - (m_a[0] + m_a[1] + m_a[2]);
+
+    // After the last sample, the deviations from the constant input decay
+    // through the forward then the backward recursion. Both are linear, so
+    // the initial state of the backward pass is a matrix product (Triggs and
+    // Sdika, 2006). Each column is computed by running the recursions on a
+    // unit deviation until it vanishes.
+    for (unsigned int k(0); k < 3; ++k)
+    {
+        // Forward deviations, the first 3 are the last outputs of the signal
+        std::vector<double> forward(3, 0.0);
+        forward[2 - k] = 1.0;
+        while (forward.size() < 100000)
+        {
+            unsigned int n(forward.size());
+            double value(m_a[0] * forward[n - 1] + m_a[1] * forward[n - 2] + m_a[2] * forward[n - 3]);
+            forward.push_back(value);
+
+            if (std::abs(value) + std::abs(forward[n - 1]) + std::abs(forward[n - 2]) < 1.0e-20)
+            {
+                break;
+            }
+        }
+
+        // Backward deviations, zero far after the end
+        std::vector<double> backward(forward.size() + 3, 0.0);
+        for (unsigned int n(forward.size()); n-- > 3;)
+        {
+            backward[n] = m_b * forward[n] +
+                    m_a[0] * backward[n + 1] + m_a[1] * backward[n + 2] + m_a[2] * backward[n + 3];
+        }
+
+        for (unsigned int i(0); i < 3; ++i)
+        {
+            m_m[i][k] = backward[3 + i];
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------
+void RecursiveGaussian::filter(double* apData,
+                               unsigned int aLength,
+                               unsigned int aNumberOfLanes,
+                               const double* apBefore,
+                               const double* apAfter) const
+//-------------------------------------------------------------------
+{
+    unsigned int lanes(aNumberOfLanes);
+
+    // The signal with 3 samples before and after it
+    std::vector<double> buffer((aLength + 6) * lanes);
+    for (unsigned int l(0); l < lanes; ++l)
+    {
+        for (unsigned int n(0); n < 3; ++n)
+        {
+            buffer[n * lanes + l] = apBefore[l];
+        }
+    }
+
+    // Forward pass, from the steady state of the constant input before the signal
+    for (unsigned int n(0); n < aLength; ++n)
+    {
+        double* p_output(&buffer[(n + 3) * lanes]);
+        const double* p_previous_1(p_output - lanes);
+        const double* p_previous_2(p_output - 2 * lanes);
+        const double* p_previous_3(p_output - 3 * lanes);
+        const double* p_input(apData + n * lanes);
+
+        for (unsigned int l(0); l < lanes; ++l)
+        {
+            p_output[l] = m_b * p_input[l] +
+                    m_a[0] * p_previous_1[l] +
+                    m_a[1] * p_previous_2[l] +
+                    m_a[2] * p_previous_3[l];
+        }
+    }
+
+    // State of the backward pass after the signal
+    for (unsigned int l(0); l < lanes; ++l)
+    {
+        double deviation[3];
+        for (unsigned int k(0); k < 3; ++k)
+        {
+            deviation[k] = buffer[(aLength + 2 - k) * lanes + l] - apAfter[l];
+        }
+
+        for (unsigned int i(0); i < 3; ++i)
+        {
+            buffer[(aLength + 3 + i) * lanes + l] = apAfter[l] +
+                    m_m[i][0] * deviation[0] + m_m[i][1] * deviation[1] + m_m[i][2] * deviation[2];
+        }
+    }
+
+    // Backward pass, written in place
+    for (unsigned int n(aLength); n-- > 0;)
+    {
+        double* p_output(&buffer[(n + 3) * lanes]);
+        const double* p_next_1(p_output + lanes);
+        const double* p_next_2(p_output + 2 * lanes);
+        const double* p_next_3(p_output + 3 * lanes);
+
+        for (unsigned int l(0); l < lanes; ++l)
+        {
+            p_output[l] = m_b * p_output[l] +
+                    m_a[0] * p_next_1[l] +
+                    m_a[1] * p_next_2[l] +
+                    m_a[2] * p_next_3[l];
+        }
+    }
+
+    std::copy(buffer.begin() + 3 * lanes, buffer.begin() + (aLength + 3) * lanes, apData);
+}
+
+
+//-----------------------------------------
+double RecursiveGaussian::getMinimumSigma()
+//-----------------------------------------
+{
+    // Lower bound of the fit of Young and van Vliet
+    return (0.5);
+}
@@ -0,0 +1,317 @@
+/**
+********************************************************************************
+*
+*   @file       Spectrum.cpp
+*
+*   @brief      Discrete Fourier transform of a real image, to filter it in
+*               the frequency domain.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <cstdint>
+
+#include "Spectrum.h"
+#include "Image.h"
+#include "ImageView.h"
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local functions
+//******************************************************************************
+
+//------------------------------------------------------------------------
+/// Transform the columns of a set of rows in place, over a range of
+/// columns.
+/**
+* @param apData: the first row
+* @param aHeight: the number of rows
+* @param aStride: the distance between two rows
+* @param aFirst: the first column
+* @param aLast: the column after the last column
+* @param anInverse: true for the inverse transform
+*/
+//------------------------------------------------------------------------
+static void transformColumns(Complex* apData,
+                             unsigned int aHeight,
+                             unsigned int aStride,
+                             unsigned int aFirst,
+                             unsigned int aLast,
+                             bool anInverse)
+//------------------------------------------------------------------------
+{
+    const FFTPlan& plan(FFTPlan::getPlan(aHeight));
+    std::vector<Complex> column(aHeight);
+    std::vector<Complex> transform(aHeight);
+
+    for (unsigned int k(aFirst); k < aLast; ++k)
+    {
+        for (unsigned int j(0); j < aHeight; ++j)
+        {
+            column[j] = apData[j * aStride + k];
+        }
+
+        plan.transform(&column[0], &transform[0], anInverse);
+
+        for (unsigned int j(0); j < aHeight; ++j)
+        {
+            apData[j * aStride + k] = transform[j];
+        }
+    }
+}
+
+
+template <typename T>
+//--------------------------------------------------------------------
+Spectrum::Spectrum(const BasicImageView<T>& aView,
+                   unsigned int aWidth,
+                   unsigned int aHeight):
+//--------------------------------------------------------------------
+        m_width(aWidth ? aWidth : aView.getWidth()),
+        m_height(aHeight ? aHeight : aView.getHeight()),
+        m_half_width(m_width / 2 + 1)
+//--------------------------------------------------------------------
+{
+    // If image is empty
+    if (aView.isEmpty())
+        throw "Image Empty";
+
+    // The view must fit in the transform
+    if (m_width < aView.getWidth() || m_height < aView.getHeight())
+        throw "The transform is smaller than the image";
+
+    m_coefficient_set.assign(m_height * m_half_width, Complex(0.0, 0.0));
+
+    // The rows are real: two rows are transformed at once, as the real and
+    // imaginary parts of a complex signal, then separated by symmetry
+    unsigned int numberOfPairs((aView.getHeight() + 1) / 2);
+    parallelForRows(numberOfPairs, [&](unsigned int aFirstPair, unsigned int aLastPair) {
+        const FFTPlan& plan(FFTPlan::getPlan(m_width));
+        std::vector<Complex> signal(m_width, Complex(0.0, 0.0));
+        std::vector<Complex> transform(m_width);
+
+        for (unsigned int pair(aFirstPair); pair < aLastPair; ++pair)
+        {
+            unsigned int j(2 * pair);
+            bool hasSecondRow(j + 1 < aView.getHeight());
+            const T* p_first(aView.getRow(j));
+            const T* p_second(hasSecondRow ? aView.getRow(j + 1) : 0);
+
+            for (unsigned int i(0); i < aView.getWidth(); ++i)
+            {
+                signal[i] = Complex(double(p_first[i]),
+                                    p_second ? double(p_second[i]) : 0.0);
+            }
+
+            plan.transform(&signal[0], &transform[0], false);
+
+            // F = (Z[k] + conj(Z[-k])) / 2 and S = (Z[k] - conj(Z[-k])) / 2i
+            Complex* p_first_output(getRow(j));
+            Complex* p_second_output(hasSecondRow ? getRow(j + 1) : 0);
+            for (unsigned int k(0); k < m_half_width; ++k)
+            {
+                Complex z(transform[k]);
+                Complex mirror(std::conj(transform[k ? m_width - k : 0]));
+                Complex sum(z + mirror);
+                Complex difference(z - mirror);
+
+                p_first_output[k] = sum * 0.5;
+                if (p_second_output)
+                {
+                    p_second_output[k] = Complex(difference.imag() * 0.5,
+                                                 -difference.real() * 0.5);
+                }
+            }
+        }
+    });
+
+    // The columns are complex, they are independent
+    ThreadPool::getInstance().parallelFor(0, m_half_width, [&](unsigned int aFirstCol, unsigned int aLastCol) {
+        transformColumns(&m_coefficient_set[0], m_height, m_half_width,
+                         aFirstCol, aLastCol, false);
+    });
+}
+
+
+//---------------------------------------
+unsigned int Spectrum::getWidth() const
+//---------------------------------------
+{
+    return (m_width);
+}
+
+
+//----------------------------------------
+unsigned int Spectrum::getHeight() const
+//----------------------------------------
+{
+    return (m_height);
+}
+
+
+//----------------------------------------
+Complex* Spectrum::getRow(unsigned int j)
+//----------------------------------------
+{
+    return (&m_coefficient_set[0] + j * m_half_width);
+}
+
+
+//----------------------------------------------------
+const Complex* Spectrum::getRow(unsigned int j) const
+//----------------------------------------------------
+{
+    return (&m_coefficient_set[0] + j * m_half_width);
+}
+
+
+//-------------------------------------------------------------------------
+Spectrum& Spectrum::multiply(const Spectrum& aSpectrum, bool aConjugate)
+//-------------------------------------------------------------------------
+{
+    checkSize(aSpectrum);
+
+    double sign(aConjugate ? -1.0 : 1.0);
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            Complex* p_output(getRow(j));
+            const Complex* p_other(aSpectrum.getRow(j));
+
+            for (unsigned int k(0); k < m_half_width; ++k)
+            {
+                double a(p_output[k].real());
+                double b(p_output[k].imag());
+                double c(p_other[k].real());
+                double d(sign * p_other[k].imag());
+
+                p_output[k] = Complex(a * c - b * d, a * d + b * c);
+            }
+        }
+    });
+
+    return (*this);
+}
+
+
+//---------------------------------------------------------------------------
+Spectrum& Spectrum::divide(const Spectrum& aSpectrum, double aRegularisation)
+//---------------------------------------------------------------------------
+{
+    checkSize(aSpectrum);
+
+    parallelForRows(m_height, [&](unsigned int aFirstRow, unsigned int aLastRow) {
+        for (unsigned int j(aFirstRow); j < aLastRow; ++j)
+        {
+            Complex* p_output(getRow(j));
+            const Complex* p_other(aSpectrum.getRow(j));
+
+            for (unsigned int k(0); k < m_half_width; ++k)
+            {
+                double a(p_output[k].real());
+                double b(p_output[k].imag());
+                double c(p_other[k].real());
+                double d(p_other[k].imag());
+                double denominator(c * c + d * d + aRegularisation);
+
+                // Nothing can be recovered where the other spectrum vanishes
+                if (denominator == 0.0)
+                    p_output[k] = Complex(0.0, 0.0);
+                else
+                    p_output[k] = Complex((a * c + b * d) / denominator,
+                                          (b * c - a * d) / denominator);
+            }
+        }
+    });
+
+    return (*this);
+}
+
+
+//----------------------------------------------
+BasicImage<double> Spectrum::inverse() const
+//----------------------------------------------
+{
+    // Inverse transforms of the columns
+    std::vector<Complex> coefficient_set(m_coefficient_set);
+    ThreadPool::getInstance().parallelFor(0, m_half_width, [&](unsigned int aFirstCol, unsigned int aLastCol) {
+        transformColumns(&coefficient_set[0], m_height, m_half_width,
+                         aFirstCol, aLastCol, true);
+    });
+
+    // Two real rows are rebuilt at once, from Z = F + iS
+    BasicImage<double> image(m_width, m_height);
+    double scale(1.0 / (double(m_width) * m_height));
+    parallelForRows((m_height + 1) / 2, [&](unsigned int aFirstPair, unsigned int aLastPair) {
+        const FFTPlan& plan(FFTPlan::getPlan(m_width));
+        std::vector<Complex> transform(m_width);
+        std::vector<Complex> signal(m_width);
+
+        for (unsigned int pair(aFirstPair); pair < aLastPair; ++pair)
+        {
+            unsigned int j(2 * pair);
+            bool hasSecondRow(j + 1 < m_height);
+            const Complex* p_first(&coefficient_set[0] + j * m_half_width);
+            const Complex* p_second(hasSecondRow ? p_first + m_half_width : 0);
+
+            for (unsigned int k(0); k < m_width; ++k)
+            {
+                // The other half of the rows is the conjugate of the stored half
+                bool stored(k < m_half_width);
+                unsigned int index(stored ? k : m_width - k);
+                Complex first(stored ? p_first[index] : std::conj(p_first[index]));
+                Complex second(0.0, 0.0);
+                if (p_second)
+                    second = stored ? p_second[index] : std::conj(p_second[index]);
+
+                transform[k] = Complex(first.real() - second.imag(),
+                                       first.imag() + second.real());
+            }
+
+            plan.transform(&transform[0], &signal[0], true);
+
+            double* p_first_output(image.getRow(j));
+            double* p_second_output(hasSecondRow ? image.getRow(j + 1) : 0);
+            for (unsigned int i(0); i < m_width; ++i)
+            {
+                p_first_output[i] = signal[i].real() * scale;
+                if (p_second_output)
+                    p_second_output[i] = signal[i].imag() * scale;
+            }
+        }
+    });
+
+    return (image);
+}
+
+
+//-------------------------------------------------------------
+void Spectrum::checkSize(const Spectrum& aSpectrum) const
+//-------------------------------------------------------------
+{
+    if (m_width != aSpectrum.m_width || m_height != aSpectrum.m_height)
+        throw "The spectra have different sizes";
+}
+
+
+//******************************************************************************
+//  Explicit instantiations
+//******************************************************************************
+template Spectrum::Spectrum(const BasicImageView<std::uint8_t>&, unsigned int, unsigned int);
+template Spectrum::Spectrum(const BasicImageView<std::uint16_t>&, unsigned int, unsigned int);
+template Spectrum::Spectrum(const BasicImageView<float>&, unsigned int, unsigned int);
+template Spectrum::Spectrum(const BasicImageView<double>&, unsigned int, unsigned int);
@@ -0,0 +1,288 @@
+/**
+********************************************************************************
+*
+*   @file       ThreadPool.cpp
+*
+*   @brief      Pool of worker threads to process images by bands of rows.
+*
+*   @version    1.0
+*
+*   @todo
+*
+*   @date       9/12/2016
+*
+*   @author     Benjamin Roberts
+*
+*
+********************************************************************************
+*/
+
+
+//******************************************************************************
+//  Include
+//******************************************************************************
+#include <algorithm> // Header file for min
+#include <cstdlib> // Header file for getenv/strtol
+#include <memory> // Header file for unique_ptr
+
+#include "ThreadPool.h"
+
+
+//******************************************************************************
+//  Local variables and functions
+//******************************************************************************
+
+/// True in the worker threads, in the calling thread while it runs a task
+/// and in the serial regions: the filters then run in the current thread
+static thread_local bool g_in_task(false);
+
+
+//------------------------------------------------------------------------
+/// Accessor on the shared pool.
+//------------------------------------------------------------------------
+static std::unique_ptr<ThreadPool>& getSharedPool()
+//------------------------------------------------------------------------
+{
+    static std::unique_ptr<ThreadPool> p_pool(new ThreadPool(0));
+    return (p_pool);
+}
+
+
+//---------------------------------------------------------
+ThreadPool::ThreadPool(unsigned int aNumberOfThreads):
+//---------------------------------------------------------
+        m_p_task(0),
+        m_begin(0),
+        m_end(0),
+        m_number_of_bands(0),
+        m_next_band(0),
+        m_finished_bands(0),
+        m_active_workers(0),
+        m_job_id(0),
+        m_stop(false)
+//---------------------------------------------------------
+{
+    if (!aNumberOfThreads)
+    {
+        aNumberOfThreads = getDefaultNumberOfThreads();
+    }
+
+    // The calling thread is one of the threads
+    for (unsigned int i(1); i < aNumberOfThreads; ++i)
+    {
+        m_p_thread_set.push_back(std::thread(&ThreadPool::runWorker, this));
+    }
+}
+
+
+//------------------------
+ThreadPool::~ThreadPool()
+//------------------------
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_job_condition.notify_all();
+
+    for (std::vector<std::thread>::iterator ite(m_p_thread_set.begin());
+            ite != m_p_thread_set.end();
+            ++ite)
+    {
+        ite->join();
+    }
+}
+
+
+//-----------------------------------------------
+unsigned int ThreadPool::getNumberOfThreads() const
+//-----------------------------------------------
+{
+    return (m_p_thread_set.size() + 1);
+}
+
+
+//-------------------------------------------------------------------------------------
+void ThreadPool::parallelFor(unsigned int aBegin, unsigned int aEnd, const RowTask& aTask)
+//-------------------------------------------------------------------------------------
+{
+    // Nothing to do
+    if (aBegin >= aEnd)
+    {
+        return;
+    }
+
+    // Nested call, single thread, single row or the pool is busy
+    // with a job from another thread: run in the current thread
+    std::unique_lock<std::mutex> job_lock(m_job_mutex, std::defer_lock);
+    if (g_in_task || m_p_thread_set.empty() || aEnd - aBegin == 1 || !job_lock.try_lock())
+    {
+        aTask(aBegin, aEnd);
+        return;
+    }
+
+    // Post the job
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // The workers that joined the previous job must have left it
+        m_done_condition.wait(lock, [this]() { return (m_active_workers == 0); });
+
+        m_p_task = &aTask;
+        m_begin = aBegin;
+        m_end = aEnd;
+        m_number_of_bands = std::min(aEnd - aBegin, getNumberOfThreads());
+        m_next_band = 0;
+        m_finished_bands = 0;
+        m_p_error = std::exception_ptr();
+        ++m_job_id;
+    }
+    m_job_condition.notify_all();
+
+    // Take part in the job, the nested calls run in this thread
+    unsigned int finished_bands(0);
+    {
+        SerialRegion serial;
+        finished_bands = processBands();
+    }
+
+    // Wait for the other bands: the task must outlive them
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished_bands += finished_bands;
+    m_done_condition.wait(lock, [this]() {
+        return (m_finished_bands == m_number_of_bands && m_active_workers == 0);
+    });
+    m_p_task = 0;
+
+    // A band has thrown, the first error is passed on to the caller
+    if (m_p_error)
+    {
+        std::exception_ptr p_error(m_p_error);
+        m_p_error = std::exception_ptr();
+        lock.unlock();
+        std::rethrow_exception(p_error);
+    }
+}
+
+
+//---------------------------------------
+ThreadPool& ThreadPool::getInstance()
+//---------------------------------------
+{
+    return (*getSharedPool());
+}
+
+
+//------------------------------------------------------------------
+void ThreadPool::setNumberOfThreads(unsigned int aNumberOfThreads)
+//------------------------------------------------------------------
+{
+    // Stop the current workers before starting the new ones
+    getSharedPool().reset();
+    getSharedPool().reset(new ThreadPool(aNumberOfThreads));
+}
+
+
+//-----------------------------------------------
+unsigned int ThreadPool::getDefaultNumberOfThreads()
+//-----------------------------------------------
+{
+    const char* p_value(std::getenv(IMAGE_NUM_THREADS_VARIABLE));
+    if (p_value)
+    {
+        long number_of_threads(std::strtol(p_value, 0, 10));
+        if (number_of_threads > 0)
+        {
+            return (number_of_threads);
+        }
+    }
+
+    return (std::max(1u, std::thread::hardware_concurrency()));
+}
+
+
+//----------------------------
+void ThreadPool::runWorker()
+//----------------------------
+{
+    g_in_task = true;
+    unsigned int last_job_id(0);
+
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_job_condition.wait(lock, [&]() { return (m_stop || m_job_id != last_job_id); });
+
+        // The pool is destroyed
+        if (m_stop)
+        {
+            return;
+        }
+
+        last_job_id = m_job_id;
+        ++m_active_workers;
+        lock.unlock();
+
+        unsigned int finished_bands(processBands());
+
+        lock.lock();
+        m_finished_bands += finished_bands;
+        --m_active_workers;
+        if (!m_active_workers)
+        {
+            m_done_condition.notify_all();
+        }
+    }
+}
+
+
+//------------------------------------
+unsigned int ThreadPool::processBands()
+//------------------------------------
+{
+    unsigned int finished_bands(0);
+    unsigned int number_of_rows(m_end - m_begin);
+
+    for (unsigned int band(m_next_band++); band < m_number_of_bands; band = m_next_band++)
+    {
+        // Contiguous bands of (almost) the same size
+        unsigned int first(m_begin + band * number_of_rows / m_number_of_bands);
+        unsigned int last(m_begin + (band + 1) * number_of_rows / m_number_of_bands);
+
+        // An error must not leave a thread, nor stop the job before every
+        // band is accounted for
+        try
+        {
+            (*m_p_task)(first, last);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_p_error)
+            {
+                m_p_error = std::current_exception();
+            }
+        }
+        ++finished_bands;
+    }
+
+    return (finished_bands);
+}
+
+
+//----------------------------
+SerialRegion::SerialRegion():
+//----------------------------
+        m_was_serial(g_in_task)
+//----------------------------
+{
+    g_in_task = true;
+}
+
+
+//----------------------------
+SerialRegion::~SerialRegion()
+//----------------------------
+{
+    g_in_task = m_was_serial;
+}
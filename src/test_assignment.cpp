@@ -88,8 +88,8 @@ int main(int argc, char** argv)
         std::cout << negative.getMinValue() << "\t" << negative.getMaxValue() << std::endl;
 
 		input_2.savePGM("output2.pgm");
-        input_2.getROI(0, 0, 400, 400).savePGM("ROI1.pgm");
-        input_2.getROI(100, 100, 300, 300).savePGM("ROI2.pgm");
+        Image(input_2.getROI(0, 0, 400, 400)).savePGM("ROI1.pgm");
+        Image(input_2.getROI(100, 100, 300, 300)).savePGM("ROI2.pgm");
     
 		// Test the copy constructor
 		Image test_image(input_1);
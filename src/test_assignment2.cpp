@@ -24,8 +24,11 @@
 #include <iomanip>
 #include <exception>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 #include "Image.h"
+#include "BatchScheduler.h"
 #include "test_assignment2.h"
 
 
@@ -145,6 +148,29 @@ void testFilters(std::string fileName) {
     
     
     // TEST FILTERS
+    
+    // The filters are independent: compute them concurrently in a single batch
+    double testArray[] = {1,1,1,
+                          1,1,1,
+                          1,1,1};
+    double testArray2[] = {1,2,1,
+                           1,2,1,
+                           1,2,1};
+    
+    std::vector<ImageJob<double> > job_set;
+    job_set.push_back(makeImageJob(image, [&](const Image& anImage) { return Image(anImage.convolution(testArray)/9); }));
+    job_set.push_back(makeImageJob(image, [&](const Image& anImage) { return Image(anImage.convolution(testArray2)/9); }));
+    job_set.push_back(makeImageJob(image_noise, [](const Image& anImage) { return anImage.medianFilter(); }));
+    job_set.push_back(makeImageJob(image_noise, [](const Image& anImage) { return anImage.gaussianFilter(); }));
+    job_set.push_back(makeImageJob(image_noise, [](const Image& anImage) { return anImage.meanFilter(); }));
+    job_set.push_back(makeImageJob(image, [](const Image& anImage) { return anImage.laplacianFilter(); }));
+    job_set.push_back(makeImageJob(image, [](const Image& anImage) { return anImage.sobelEdgeDetector(); }));
+    job_set.push_back(makeImageJob(image, [](const Image& anImage) { return anImage.prewittEdgeDetector(); }));
+    job_set.push_back(makeImageJob(image, [](const Image& anImage) { return anImage.sharpening(4); }));
+    job_set.push_back(makeImageJob(image, [](const Image& anImage) { return anImage.binaryThresholding(125).toImage(255); }));
+    
+    std::vector<Image> filtered_image_set(processBatch(job_set));
+    
     std::cout << std::endl << std::endl;
     std::cout << "FILTER TYPE:\t" << " SAE  " << " MAE  " << "  NCC   " << "   STATUS" << std::endl;
     
@@ -154,10 +180,7 @@ void testFilters(std::string fileName) {
     
     //============= CONVOLUTION ===============
     // Convolution on image
-    double testArray[] = {1,1,1,
-                          1,1,1,
-                          1,1,1};
-    Image my_image_convoultion( image.convolution(testArray)/9);
+    Image my_image_convoultion(std::move(filtered_image_set[0]));
     my_image_convoultion.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_convolution.txt");
     
     // Same filter on ImageJ
@@ -179,10 +202,7 @@ void testFilters(std::string fileName) {
     
     //============= CONVOLUTION2 ===============
     // Convolution on image
-    double testArray2[] = {1,2,1,
-                           1,2,1,
-                           1,2,1};
-    Image my_image_convoultion2( image.convolution(testArray2)/9 );
+    Image my_image_convoultion2(std::move(filtered_image_set[1]));
     my_image_convoultion.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_convolution2.txt");
     
     // Same filter on ImageJ
@@ -206,7 +226,7 @@ void testFilters(std::string fileName) {
     //======== MEDIAN FILTER ==========
     
     // Median filter on image with salt and pepper noise
-    Image my_image_noise_median_filter(image_noise.medianFilter());
+    Image my_image_noise_median_filter(std::move(filtered_image_set[2]));
     my_image_noise_median_filter.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_noise_median_filter.txt");
     
     // Same filter on ImageJ
@@ -234,7 +254,7 @@ void testFilters(std::string fileName) {
     //======== GAUSSIAN FILTER ==========
     
     // Gaussian filter on image with salt and pepper noise
-    Image my_image_noise_gaussian_filter(image_noise.gaussianFilter());
+    Image my_image_noise_gaussian_filter(std::move(filtered_image_set[3]));
     my_image_noise_gaussian_filter.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_noise_gaussian_filter.txt");
     
     // Same filter on ImageJ
@@ -259,7 +279,7 @@ void testFilters(std::string fileName) {
     //======== MEAN FILTER ==========
     
     // Mean filter (also called box filter and average filter) on image with salt and pepper noise
-    Image my_image_noise_mean_filter(image_noise.meanFilter());
+    Image my_image_noise_mean_filter(std::move(filtered_image_set[4]));
     my_image_noise_mean_filter.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_noise_mean_filter.txt");
     // Same filter on ImageJ
     Image imagej_image_noise_mean_filter;
@@ -283,7 +303,7 @@ void testFilters(std::string fileName) {
     //======== LAPLACIAN FILTER ==========
     
     // Laplacian filter on image
-    Image my_image_laplacian_filter(image.laplacianFilter());
+    Image my_image_laplacian_filter(std::move(filtered_image_set[5]));
     my_image_laplacian_filter.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_laplacian_filter.txt");
     // Same filter on ImageJ
     Image imagej_image_laplacian_filter;
@@ -308,7 +328,7 @@ void testFilters(std::string fileName) {
     //======== SOBEL EDGE DETECTOR ==========
     
     // Sobel edge detector on image
-    Image my_image_sobel_edge_detector(image.sobelEdgeDetector());
+    Image my_image_sobel_edge_detector(std::move(filtered_image_set[6]));
     my_image_sobel_edge_detector.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_sobel_edge_detector.txt");
     // Same filter on ImageJ
     Image imagej_image_sobel_edge_detector;
@@ -333,7 +353,7 @@ void testFilters(std::string fileName) {
     //======== PREWITT EDGE DETECTOR =========
     
     // Prewitt edge detector on image
-    Image my_image_prewitt_edge_detector(image.sobelEdgeDetector());
+    Image my_image_prewitt_edge_detector(std::move(filtered_image_set[7]));
     my_image_prewitt_edge_detector.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_prewitt_edge_detector.txt");
     // Same filter on ImageJ
     Image imagej_image_prewitt_edge_detector;
@@ -359,7 +379,7 @@ void testFilters(std::string fileName) {
     //============== SHARPEN ================
     
     // Sharpen on image, with value 'a' equal to 4.
-    Image my_image_sharpen(image.sharpening(4));
+    Image my_image_sharpen(std::move(filtered_image_set[8]));
     my_image_sharpen.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_sharpen.txt");
     // Same filter on ImageJ
     Image imagej_image_sharpen;
@@ -384,7 +404,7 @@ void testFilters(std::string fileName) {
     //======== THRESHOLDING ==========
     
     // Change threshold values on image
-    Image my_image_threshold(image.segmentationThresholding(125)*255);
+    Image my_image_threshold(std::move(filtered_image_set[9]));
     my_image_threshold.saveASCII("img/eeu47d-images/eeu47d-Code Images/my_"+fileName+"_threshold.txt");
     // Same filter on ImageJ
     Image imagej_image_threshold;